@@ -1,5 +1,11 @@
 # C++ standard
-set(CMAKE_CXX_STANDARD 17)
+option(ENABLE_CXX20 "Build with C++20, enables coroutine support" OFF)
+
+if (ENABLE_CXX20)
+    set(CMAKE_CXX_STANDARD 20)
+else()
+    set(CMAKE_CXX_STANDARD 17)
+endif (ENABLE_CXX20)
 set(CMAKE_CXX_STANDARD_REQUIRED ON)
 set(CMAKE_CXX_EXTENSIONS OFF)
 
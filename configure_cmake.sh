@@ -25,6 +25,7 @@ Usage: $0 [OPTION]... [VAR=VALUE]...
 Optional Features:
     --build-type=[Debug|Release] set cmake build type
     --enable-unit-test           enable unit tests
+    --enable-cxx20               build with C++20, enables coroutine support
     --enable-address-sanitizer   enable address sanitizer support
     --enable-ub-sanitizer        enable undefined behavior sanitizer support
     --enable-thread-sanitizer    enable thread sanitizer support
@@ -81,6 +82,9 @@ while [ $# -ne 0 ]; do
         --enable-unit-tests)
             append_cache_entry ENABLE_UNIT_TESTS        BOOL true
             ;;
+        --enable-cxx20)
+            append_cache_entry ENABLE_CXX20             BOOL true
+            ;;
         --enable-address-sanitizer)
             append_cache_entry ENABLE_ADDRESS_SANITIZER BOOL true
             ;;
@@ -38,15 +38,17 @@ int main()
         [](Context<UnixSocket>& ctx)
         {
             std::error_code ec;
-            auto result = ctx.readThenUnpack<EchoMessage>(ec);
-            if (!result)
+            ctx.readThenUnpackAll<EchoMessage>(
+                [&ctx](const EchoMessage& message)
+                {
+                    std::cout << "Received: " << message.text << std::endl;
+                    std::error_code sendEc;
+                    ctx.packThenSend(EchoMessage{message.text}, sendEc);
+                },
+                ec);
+            if (ec)
             {
-                std::cerr << "Error: " << (int)result.error() << std::endl;
-            }
-            else
-            {
-                std::cout << "Received: " << result->text << std::endl;
-                ctx.packThenSend(EchoMessage{result->text}, ec);
+                std::cerr << "Error: " << ec.message() << std::endl;
             }
         });
 
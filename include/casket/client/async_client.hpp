@@ -0,0 +1,440 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+#include <casket/multiplexing/epoll_poller.hpp>
+#include <casket/pack/correlated.hpp>
+#include <casket/pack/pack.hpp>
+#include <casket/transport/byte_buffer.hpp>
+#include <casket/transport/socket_ops.hpp>
+#include <casket/transport/tcp_socket.hpp>
+#include <casket/transport/unix_socket.hpp>
+
+namespace casket
+{
+
+struct AsyncClientConfig
+{
+    size_t bufferSize{8192};       ///< Initial size of the read and write buffers, 0 allocates on first use.
+    size_t maxBufferSize{1 << 20}; ///< Upper bound of either buffer, hence of a single message.
+    size_t maxInFlight{64};        ///< Requests awaiting a response, request() fails beyond that.
+};
+
+/// @brief Client keeping many requests in flight on one connection.
+/// @details Requests are sent as Correlated<Request> with increasing ids and responses are matched by id, so the
+///          server may answer in any order. request() only queues, poll() connects, sends everything queued with
+///          as few writes as possible and dispatches the responses that arrived. Callbacks run inside poll() and
+///          must not call poll() themselves; views in a response are only valid during its callback.
+/// @tparam Buffer ByteBuffer or MirroredRingBuffer.
+template <typename Transport, typename Buffer = ByteBuffer>
+class AsyncClient
+{
+public:
+    /// Receives either an error and nullptr, or a clear error code and the response.
+    template <typename Response>
+    using Callback = std::function<void(const std::error_code&, const Response*)>;
+
+    explicit AsyncClient(const AsyncClientConfig& config = AsyncClientConfig{})
+        : config_(config)
+        , readBuffer_(config.bufferSize)
+        , writeBuffer_(config.bufferSize)
+    {
+        pending_.reserve(config_.maxInFlight);
+    }
+
+    ~AsyncClient() noexcept
+    {
+        close();
+    }
+
+    AsyncClient(const AsyncClient&) = delete;
+    AsyncClient& operator=(const AsyncClient&) = delete;
+
+    /// @brief Starts a non-blocking connect, poll() completes it; requests may be queued right away.
+    bool connect(const std::string& address, int port, std::error_code& ec)
+    {
+        bool started = false;
+        if constexpr (std::is_same_v<Transport, UnixSocket>)
+        {
+            started = transport_.connect(address, true, ec);
+        }
+        else if constexpr (std::is_same_v<Transport, TcpSocket>)
+        {
+            started = transport_.connect(address, static_cast<uint16_t>(port), true, ec);
+        }
+        if (!started)
+        {
+            return false;
+        }
+
+        poller_.add(transport_.getFd(), EventType::Readable | EventType::Writable | EventType::EdgeTriggered, ec);
+        if (ec)
+        {
+            transport_.close();
+            return false;
+        }
+        connected_ = false;
+        return true;
+    }
+
+    /// @brief Closes the connection, pending requests complete with operation_canceled.
+    void close()
+    {
+        fail(std::make_error_code(std::errc::operation_canceled));
+    }
+
+    bool isConnected() const
+    {
+        return transport_.isValid() && connected_;
+    }
+
+    bool isValid() const
+    {
+        return transport_.isValid();
+    }
+
+    /// @brief Requests awaiting their response.
+    size_t inFlight() const
+    {
+        return pending_.size();
+    }
+
+    /// @brief Queues message, callback runs once the response arrives or the connection fails.
+    /// @details Fails with resource_unavailable_try_again while maxInFlight requests are pending, poll() makes room.
+    template <typename Response, typename Request>
+    bool request(const Request& message, Callback<Response> callback, std::error_code& ec)
+    {
+        if (!transport_.isValid())
+        {
+            ec = std::make_error_code(std::errc::not_connected);
+            return false;
+        }
+        if (pending_.size() >= config_.maxInFlight)
+        {
+            ec = std::make_error_code(std::errc::resource_unavailable_try_again);
+            return false;
+        }
+
+        uint64_t id = nextId_;
+        if (!packRequest(id, message, ec))
+        {
+            return false;
+        }
+        ++nextId_;
+
+        pending_.emplace(id,
+                         [callback = std::move(callback)](Unpacker* unpacker, const std::error_code& error)
+                         {
+                             if (!unpacker)
+                             {
+                                 callback(error, nullptr);
+                                 return ParseStatus::Done;
+                             }
+
+                             auto response = Response::unpack(*unpacker);
+                             if (!response)
+                             {
+                                 return response.error() == UnpackerError::PrematureEnd ? ParseStatus::Incomplete
+                                                                                        : ParseStatus::Malformed;
+                             }
+                             callback(error, &response.value());
+                             return ParseStatus::Done;
+                         });
+        return true;
+    }
+
+    /// @brief Runs one round of the event loop, waiting up to timeoutMs for the socket.
+    /// @return number of responses dispatched, ec is set if the connection failed.
+    size_t poll(int timeoutMs, std::error_code& ec)
+    {
+        if (!transport_.isValid())
+        {
+            ec = std::make_error_code(std::errc::not_connected);
+            return 0;
+        }
+
+        if (connected_ && writeBuffer_.availableRead() > 0 && !flushOutput(ec))
+        {
+            return 0;
+        }
+
+        PollEvent event;
+        int count = poller_.wait(&event, 1, timeoutMs, ec);
+        if (ec)
+        {
+            if (ec == std::errc::interrupted)
+            {
+                ec.clear();
+            }
+            return 0;
+        }
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        if (!connected_)
+        {
+            ec = GetSocketError(transport_.getFd());
+            if (ec)
+            {
+                fail(ec);
+                return 0;
+            }
+            connected_ = true;
+        }
+
+        size_t dispatched = 0;
+        if ((event.revents & EventType::Readable) != EventType::None)
+        {
+            dispatched = readResponses(ec);
+            if (ec)
+            {
+                return dispatched;
+            }
+        }
+
+        if ((event.revents & (EventType::Error | EventType::HangUp)) != EventType::None)
+        {
+            ec = std::make_error_code(std::errc::connection_reset);
+            fail(ec);
+            return dispatched;
+        }
+
+        if ((event.revents & EventType::Writable) != EventType::None && writeBuffer_.availableRead() > 0)
+        {
+            flushOutput(ec);
+        }
+        return dispatched;
+    }
+
+    /// @brief Polls until no request is pending or timeout expires, returns whether all completed.
+    bool waitAll(std::chrono::milliseconds timeout, std::error_code& ec)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!pending_.empty() && transport_.isValid())
+        {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline -
+                                                                              std::chrono::steady_clock::now());
+            if (left.count() <= 0)
+            {
+                ec = std::make_error_code(std::errc::timed_out);
+                return false;
+            }
+
+            poll(static_cast<int>(left.count()), ec);
+            if (ec)
+            {
+                return false;
+            }
+        }
+        return pending_.empty();
+    }
+
+private:
+    enum class ParseStatus
+    {
+        Done,
+        Incomplete,
+        Malformed
+    };
+
+    using Completion = std::function<ParseStatus(Unpacker*, const std::error_code&)>;
+
+    template <typename Request>
+    bool packRequest(uint64_t id, const Request& message, std::error_code& ec)
+    {
+        for (;;)
+        {
+            Packer packer(writeBuffer_.getWritePtr(), writeBuffer_.availableWrite());
+            if (packer.pack(id) && message.pack(packer))
+            {
+                writeBuffer_.commitWrite(packer.position());
+                return true;
+            }
+
+            size_t available = writeBuffer_.availableWrite();
+            writeBuffer_.compact();
+            if (writeBuffer_.availableWrite() > available)
+            {
+                continue;
+            }
+            if (writeBuffer_.capacity() >= config_.maxBufferSize)
+            {
+                ec = std::make_error_code(std::errc::no_buffer_space);
+                return false;
+            }
+            writeBuffer_.expand(std::min(std::max(writeBuffer_.capacity() * 2, kMinBufferSize), config_.maxBufferSize));
+        }
+    }
+
+    bool flushOutput(std::error_code& ec)
+    {
+        while (writeBuffer_.availableRead() > 0)
+        {
+            ssize_t n = transport_.sendBuffer(writeBuffer_, ec);
+            if (n > 0)
+            {
+                continue;
+            }
+            if (ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block)
+            {
+                ec.clear();
+                return true;
+            }
+            if (ec == std::errc::interrupted)
+            {
+                continue;
+            }
+            fail(ec);
+            return false;
+        }
+        return true;
+    }
+
+    // Drains the socket, a response larger than maxBufferSize fails the connection.
+    size_t readResponses(std::error_code& ec)
+    {
+        size_t dispatched = 0;
+        for (;;)
+        {
+            bool full = false;
+            for (;;)
+            {
+                if (readBuffer_.availableWrite() == 0)
+                {
+                    readBuffer_.compact();
+                }
+                if (readBuffer_.availableWrite() == 0)
+                {
+                    if (readBuffer_.capacity() >= config_.maxBufferSize)
+                    {
+                        full = true;
+                        break;
+                    }
+                    readBuffer_.expand(
+                        std::min(std::max(readBuffer_.capacity() * 2, kMinBufferSize), config_.maxBufferSize));
+                }
+
+                ssize_t n = transport_.recvBuffer(readBuffer_, ec);
+                if (n > 0)
+                {
+                    continue;
+                }
+                if (ec == std::errc::interrupted)
+                {
+                    continue;
+                }
+                if (ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block)
+                {
+                    ec.clear();
+                    break;
+                }
+
+                // Deliver what arrived before the peer went away.
+                dispatched += dispatchResponses(ec);
+                ec = ec ? ec : std::make_error_code(std::errc::connection_reset);
+                fail(ec);
+                return dispatched;
+            }
+
+            size_t count = dispatchResponses(ec);
+            dispatched += count;
+            if (ec || !transport_.isValid() || !full)
+            {
+                return dispatched;
+            }
+            if (count == 0)
+            {
+                ec = std::make_error_code(std::errc::message_size);
+                fail(ec);
+                return dispatched;
+            }
+        }
+    }
+
+    size_t dispatchResponses(std::error_code& ec)
+    {
+        size_t count = 0;
+        while (readBuffer_.availableRead() > 0 && transport_.isValid())
+        {
+            Unpacker unpacker(readBuffer_.getReadPtr(), readBuffer_.availableRead());
+            auto id = unpacker.unpackUInt64();
+            if (!id && id.error() == UnpackerError::PrematureEnd)
+            {
+                break;
+            }
+
+            auto it = id ? pending_.find(id.value()) : pending_.end();
+            if (it == pending_.end())
+            {
+                // Without a known request there is no way to tell where the message ends.
+                ec = std::make_error_code(std::errc::bad_message);
+                fail(ec);
+                break;
+            }
+
+            Completion completion = std::move(it->second);
+            pending_.erase(it);
+            auto status = completion(&unpacker, std::error_code{});
+            if (status == ParseStatus::Incomplete)
+            {
+                pending_.emplace(id.value(), std::move(completion));
+                break;
+            }
+            if (status == ParseStatus::Malformed)
+            {
+                ec = std::make_error_code(std::errc::bad_message);
+                fail(ec);
+                break;
+            }
+
+            ++count;
+            if (transport_.isValid())
+            {
+                readBuffer_.commitRead(unpacker.position());
+            }
+        }
+        return count;
+    }
+
+    // Closes the connection and completes every pending request with ec.
+    void fail(const std::error_code& ec)
+    {
+        if (transport_.isValid())
+        {
+            std::error_code ignored;
+            poller_.remove(transport_.getFd(), ignored);
+            transport_.close();
+        }
+        connected_ = false;
+        readBuffer_.clear();
+        writeBuffer_.clear();
+
+        auto pending = std::move(pending_);
+        pending_.clear();
+        for (auto& entry : pending)
+        {
+            entry.second(nullptr, ec);
+        }
+    }
+
+private:
+    static constexpr size_t kMinBufferSize = 4096; ///< First allocation of a buffer that starts empty.
+
+    AsyncClientConfig config_;
+    Transport transport_;
+    EpollPoller poller_;
+    Buffer readBuffer_;
+    Buffer writeBuffer_;
+    std::unordered_map<uint64_t, Completion> pending_;
+    uint64_t nextId_{0};
+    bool connected_{false};
+};
+
+} // namespace casket
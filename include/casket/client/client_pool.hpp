@@ -0,0 +1,370 @@
+#pragma once
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <casket/client/generic_client.hpp>
+#include <casket/lock_free/lf_object_pool.hpp>
+
+namespace casket
+{
+
+struct ClientPoolConfig
+{
+    size_t connections{8};                                ///< Connections kept to the endpoint.
+    size_t bufferSize{8192};                              ///< Initial buffer size of every client.
+    bool nonblocking{false};                              ///< Connect and keep the sockets non-blocking.
+    std::chrono::milliseconds connectTimeout{1000};       ///< Non-blocking connects only.
+    std::chrono::milliseconds healthCheckInterval{1000};  ///< Idle time after which a connection is probed.
+    std::chrono::milliseconds initialBackoff{50};         ///< Delay after the first failed connect.
+    std::chrono::milliseconds maxBackoff{5000};           ///< Cap of the doubling delay.
+};
+
+/// @brief Fixed set of warm GenericClient connections to one endpoint.
+/// @details checkout() pops an idle connection from a lock-free stack and the returned Lease pushes it back, so
+///          the request path neither locks nor connects while the endpoint is healthy. A connection idle for
+///          healthCheckInterval is probed with a non-blocking peek before it is handed out, one the peer closed
+///          is replaced right away. Failed connects back off exponentially per connection, meanwhile checkout()
+///          reports the last connect error instead of retrying. maintain() runs the same checks for every idle
+///          connection and is meant to be called periodically, off the request path. It claims one connection
+///          at a time in place, checkout() steps over that one, so maintenance never empties the pool.
+/// @tparam Buffer ByteBuffer or MirroredRingBuffer.
+template <typename Transport, typename Buffer = ByteBuffer>
+class ClientPool
+{
+public:
+    using Client = GenericClient<Transport, Buffer>;
+    using Clock = std::chrono::steady_clock;
+
+private:
+    enum SlotState : uint8_t
+    {
+        Idle,
+        Leased,
+        Maintained
+    };
+
+    struct Slot
+    {
+        explicit Slot(size_t bufferSize)
+            : client(bufferSize)
+        {
+        }
+
+        Client client;
+        Clock::time_point lastUsed{};
+        Clock::time_point retryAt{};
+        std::chrono::milliseconds backoff{0};
+        std::error_code lastError;
+        size_t index{0}; ///< Position in all_ and states_.
+    };
+
+public:
+    /// @brief Exclusive use of one pooled connection, returned to the pool on destruction.
+    class Lease
+    {
+    public:
+        Lease() = default;
+
+        ~Lease() noexcept
+        {
+            release();
+        }
+
+        Lease(Lease&& other) noexcept
+            : pool_(std::exchange(other.pool_, nullptr))
+            , slot_(std::exchange(other.slot_, nullptr))
+        {
+        }
+
+        Lease& operator=(Lease&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                pool_ = std::exchange(other.pool_, nullptr);
+                slot_ = std::exchange(other.slot_, nullptr);
+            }
+            return *this;
+        }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        explicit operator bool() const noexcept
+        {
+            return slot_ != nullptr;
+        }
+
+        Client& operator*() const noexcept
+        {
+            return slot_->client;
+        }
+
+        Client* operator->() const noexcept
+        {
+            return &slot_->client;
+        }
+
+        /// @brief Closes the connection, e.g. after a protocol error; the next checkout reconnects.
+        void discard() noexcept
+        {
+            if (slot_)
+            {
+                slot_->client.close();
+            }
+        }
+
+        /// @brief Returns the connection before the lease goes out of scope.
+        void release() noexcept
+        {
+            if (slot_)
+            {
+                pool_->checkin(slot_);
+                pool_ = nullptr;
+                slot_ = nullptr;
+            }
+        }
+
+    private:
+        friend class ClientPool;
+
+        Lease(ClientPool* pool, Slot* slot)
+            : pool_(pool)
+            , slot_(slot)
+        {
+        }
+
+        ClientPool* pool_{nullptr};
+        Slot* slot_{nullptr};
+    };
+
+    /// @param[in] port ignored for UnixSocket.
+    ClientPool(std::string address, int port, const ClientPoolConfig& config = ClientPoolConfig{})
+        : config_(config)
+        , address_(std::move(address))
+        , port_(port)
+        , slots_(config.connections, config.bufferSize)
+        , states_(config.connections)
+    {
+        // The free stack only hands out its top, maintain() walks the slots by index instead.
+        all_.reserve(slots_.size());
+        while (Slot* slot = slots_.acquire())
+        {
+            slot->index = all_.size();
+            all_.push_back(slot);
+        }
+        for (auto it = all_.rbegin(); it != all_.rend(); ++it)
+        {
+            slots_.release(*it);
+        }
+    }
+
+    ClientPool(const ClientPool&) = delete;
+    ClientPool& operator=(const ClientPool&) = delete;
+
+    /// @brief Connects every idle connection, ignoring backoff.
+    /// @return whether all of them are connected, ec holds the last connect error otherwise.
+    bool warmUp(std::error_code& ec)
+    {
+        return refresh(true, ec) == slots_.size();
+    }
+
+    /// @brief Probes idle connections and reconnects broken ones whose backoff expired.
+    /// @return number of idle connections that are connected afterwards.
+    size_t maintain(std::error_code& ec)
+    {
+        return refresh(false, ec);
+    }
+
+    /// @brief Hands out an idle connection, probing or reconnecting it first when needed.
+    /// @details Fails with resource_unavailable_try_again when all connections are leased, and with the last
+    ///          connect error while the connection it picked is backing off.
+    Lease checkout(std::error_code& ec)
+    {
+        Slot* slot = claim();
+        if (!slot)
+        {
+            ec = std::make_error_code(std::errc::resource_unavailable_try_again);
+            return Lease();
+        }
+
+        if (!prepare(*slot, Clock::now(), false, ec))
+        {
+            states_[slot->index].store(Idle, std::memory_order_release);
+            slots_.release(slot);
+            return Lease();
+        }
+        ec.clear();
+        return Lease(this, slot);
+    }
+
+    size_t size() const noexcept
+    {
+        return slots_.size();
+    }
+
+    size_t leased() const noexcept
+    {
+        return slots_.activeCount();
+    }
+
+    uint64_t connects() const noexcept
+    {
+        return connects_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t failedConnects() const noexcept
+    {
+        return failedConnects_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t failedHealthChecks() const noexcept
+    {
+        return failedHealthChecks_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void checkin(Slot* slot) noexcept
+    {
+        // Leftover bytes belong to an unfinished exchange and would corrupt the next one.
+        if (slot->client.hasDataToRead() || slot->client.hasDataToWrite())
+        {
+            slot->client.close();
+            slot->client.clear();
+        }
+        slot->lastUsed = Clock::now();
+        states_[slot->index].store(Idle, std::memory_order_release);
+        slots_.release(slot);
+    }
+
+    bool tryLease(Slot& slot) noexcept
+    {
+        uint8_t expected = Idle;
+        return states_[slot.index].compare_exchange_strong(expected, Leased, std::memory_order_acq_rel);
+    }
+
+    // A slot claimed by maintain() stays in the free stack, the one beneath it is taken instead.
+    Slot* claim() noexcept
+    {
+        for (size_t attempt = 0; attempt < slots_.size(); ++attempt)
+        {
+            Slot* slot = slots_.acquire();
+            if (!slot || tryLease(*slot))
+            {
+                return slot;
+            }
+
+            Slot* next = slots_.acquire();
+            slots_.release(slot);
+            if (!next || tryLease(*next))
+            {
+                return next;
+            }
+            slots_.release(next);
+        }
+        return nullptr;
+    }
+
+    // Claims, checks and returns one idle slot at a time, leased ones are left to their holders.
+    size_t refresh(bool force, std::error_code& ec)
+    {
+        size_t connected = 0;
+        for (Slot* slot : all_)
+        {
+            uint8_t expected = Idle;
+            if (!states_[slot->index].compare_exchange_strong(expected, Maintained, std::memory_order_acq_rel))
+            {
+                continue;
+            }
+
+            std::error_code error;
+            if (prepare(*slot, Clock::now(), force, error))
+            {
+                ++connected;
+            }
+            else
+            {
+                ec = error;
+            }
+            states_[slot->index].store(Idle, std::memory_order_release);
+        }
+        return connected;
+    }
+
+    bool prepare(Slot& slot, Clock::time_point now, bool force, std::error_code& ec)
+    {
+        if (slot.client.isValid())
+        {
+            if (now - slot.lastUsed < config_.healthCheckInterval || isHealthy(slot))
+            {
+                return true;
+            }
+            failedHealthChecks_.fetch_add(1, std::memory_order_relaxed);
+            slot.client.close();
+            slot.client.clear();
+        }
+
+        if (!force && now < slot.retryAt)
+        {
+            ec = slot.lastError;
+            return false;
+        }
+        return connect(slot, now, ec);
+    }
+
+    bool connect(Slot& slot, Clock::time_point now, std::error_code& ec)
+    {
+        if (slot.client.connect(address_, port_, config_.nonblocking, ec) &&
+            (!config_.nonblocking || slot.client.isConnected(config_.connectTimeout, ec)))
+        {
+            connects_.fetch_add(1, std::memory_order_relaxed);
+            slot.lastUsed = now;
+            slot.backoff = std::chrono::milliseconds(0);
+            slot.lastError.clear();
+            return true;
+        }
+
+        failedConnects_.fetch_add(1, std::memory_order_relaxed);
+        slot.client.close();
+        slot.backoff = slot.backoff.count() == 0 ? config_.initialBackoff
+                                                 : std::min(slot.backoff * 2, config_.maxBackoff);
+        slot.retryAt = now + slot.backoff;
+        slot.lastError = ec ? ec : std::make_error_code(std::errc::not_connected);
+        ec = slot.lastError;
+        return false;
+    }
+
+    // An idle connection must have nothing to read: EOF means the peer closed it, data means a stray reply.
+    static bool isHealthy(Slot& slot)
+    {
+        uint8_t byte;
+        struct iovec iov{&byte, 1};
+        struct msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+
+        std::error_code ec;
+        ssize_t n = slot.client.getTransport().recvmsg(&msg, MSG_PEEK | MSG_DONTWAIT, ec);
+        return n <= 0 && (ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block);
+    }
+
+private:
+    ClientPoolConfig config_;
+    std::string address_;
+    int port_;
+    lf::ObjectPool<Slot> slots_;
+    std::vector<Slot*> all_;
+    std::vector<std::atomic<uint8_t>> states_; ///< SlotState of every slot, indexed by Slot::index.
+    std::atomic<uint64_t> connects_{0};
+    std::atomic<uint64_t> failedConnects_{0};
+    std::atomic<uint64_t> failedHealthChecks_{0};
+};
+
+} // namespace casket
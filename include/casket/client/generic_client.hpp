@@ -9,12 +9,14 @@
 #include <casket/transport/tcp_socket.hpp>
 
 #include <casket/transport/byte_buffer.hpp>
+#include <casket/transport/mirrored_ring_buffer.hpp>
 #include <casket/pack/pack.hpp>
 
 namespace casket
 {
 
-template <typename Transport>
+/// @tparam Buffer ByteBuffer or MirroredRingBuffer.
+template <typename Transport, typename Buffer = ByteBuffer>
 class GenericClient
 {
 public:
@@ -178,19 +180,19 @@ public:
         return transport_;
     }
 
-    ByteBuffer& getReadBuffer()
+    Buffer& getReadBuffer()
     {
         return readBuffer_;
     }
-    ByteBuffer& getWriteBuffer()
+    Buffer& getWriteBuffer()
     {
         return writeBuffer_;
     }
 
 private:
     Transport transport_;
-    ByteBuffer readBuffer_;
-    ByteBuffer writeBuffer_;
+    Buffer readBuffer_;
+    Buffer writeBuffer_;
 };
 
 } // namespace casket
\ No newline at end of file
@@ -0,0 +1,147 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <casket/concurrency/thread_slot.hpp>
+
+namespace casket
+{
+
+/// @brief Left-right double-buffered value: readers never retry and never wait for a writer's copy.
+/// @details Two instances of the value are kept. Readers announce themselves on a per-slot counter of the
+///          current version and read the instance that writers left readable. A writer updates the other
+///          instance, redirects new readers to it, waits until the readers of the previous version leave
+///          and then brings the old instance up to date. Writes are serialized by a mutex and cost two
+///          copies, reads are wait-free, which fits large or non-trivially-copyable read-mostly payloads.
+/// @note The functor given to read() runs while writers may be waiting for it, it should be short.
+template <typename T>
+class DoubleBufferedLock
+{
+public:
+    explicit DoubleBufferedLock(const T& initial = T{}, size_t slots = DefaultSlotCount())
+        : instances_{initial, initial}
+        , indicators_{ReaderIndicator(slots), ReaderIndicator(slots)}
+    {
+    }
+
+    DoubleBufferedLock(const DoubleBufferedLock&) = delete;
+    DoubleBufferedLock& operator=(const DoubleBufferedLock&) = delete;
+
+    /// @brief Calls fn with a const reference to the current value and returns its result.
+    template <typename Fn>
+    decltype(auto) read(Fn&& fn) const
+    {
+        ReaderIndicator& indicator = indicators_[versionIndex_.load(std::memory_order_seq_cst)];
+        ReadScope scope(indicator);
+        return fn(instances_[leftRight_.load(std::memory_order_seq_cst)]);
+    }
+
+    T load() const
+    {
+        return read([](const T& value) { return value; });
+    }
+
+    void store(const T& desired)
+    {
+        modify([&desired](T& value) { value = desired; });
+    }
+
+    /// @brief Applies fn to both instances in turn, fn must leave them equal.
+    template <typename Fn>
+    void modify(Fn&& fn)
+    {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+
+        unsigned current = leftRight_.load(std::memory_order_relaxed);
+        fn(instances_[current ^ 1]);
+        leftRight_.store(current ^ 1, std::memory_order_seq_cst);
+
+        unsigned previous = versionIndex_.load(std::memory_order_relaxed);
+        indicators_[previous ^ 1].waitEmpty();
+        versionIndex_.store(previous ^ 1, std::memory_order_seq_cst);
+        indicators_[previous].waitEmpty();
+
+        fn(instances_[current]);
+    }
+
+private:
+    class ReaderIndicator
+    {
+    public:
+        explicit ReaderIndicator(size_t slots)
+            : slots_(RoundUpToPowerOfTwo(slots))
+            , mask_(slots_.size() - 1)
+        {
+        }
+
+        ReaderIndicator(ReaderIndicator&& other) noexcept
+            : slots_(std::move(other.slots_))
+            , mask_(other.mask_)
+        {
+        }
+
+        size_t arrive() noexcept
+        {
+            size_t slot = CurrentThreadSlot() & mask_;
+            slots_[slot].readers.fetch_add(1, std::memory_order_seq_cst);
+            return slot;
+        }
+
+        void depart(size_t slot) noexcept
+        {
+            slots_[slot].readers.fetch_sub(1, std::memory_order_release);
+        }
+
+        void waitEmpty() const noexcept
+        {
+            for (const auto& slot : slots_)
+            {
+                while (slot.readers.load(std::memory_order_seq_cst) != 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+        struct alignas(64) Slot
+        {
+            std::atomic<uint32_t> readers{0};
+        };
+
+        std::vector<Slot> slots_;
+        size_t mask_;
+    };
+
+    class ReadScope
+    {
+    public:
+        explicit ReadScope(ReaderIndicator& indicator) noexcept
+            : indicator_(indicator)
+            , slot_(indicator.arrive())
+        {
+        }
+
+        ~ReadScope() noexcept
+        {
+            indicator_.depart(slot_);
+        }
+
+        ReadScope(const ReadScope&) = delete;
+        ReadScope& operator=(const ReadScope&) = delete;
+
+    private:
+        ReaderIndicator& indicator_;
+        size_t slot_;
+    };
+
+private:
+    T instances_[2];
+    alignas(64) std::atomic<unsigned> leftRight_{0};
+    std::atomic<unsigned> versionIndex_{0};
+    mutable ReaderIndicator indicators_[2];
+    std::mutex writerMutex_;
+};
+
+} // namespace casket
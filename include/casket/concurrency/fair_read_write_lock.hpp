@@ -0,0 +1,157 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <casket/concurrency/futex.hpp>
+#include <casket/concurrency/read_write_lock.hpp>
+
+namespace casket
+{
+
+/// @brief Writer-preferring read-write lock that parks waiting threads on a futex.
+/// @details Once a writer is waiting no new reader gets in, so a steady stream of readers cannot starve
+///          writers. Contended threads spin briefly and then sleep in the kernel instead of yielding,
+///          which leaves the CPU to the lock holder. Readers waiting behind writers are released
+///          together when the last queued writer unlocks.
+class FairReadWriteLock final
+{
+private:
+    static constexpr uint32_t WRITER_BIT = 1 << 0;
+    static constexpr uint32_t READER_UNIT = 1 << 1;
+    static constexpr int SPIN_COUNT = 64;
+
+public:
+    FairReadWriteLock() noexcept = default;
+
+    FairReadWriteLock(const FairReadWriteLock&) = delete;
+    FairReadWriteLock& operator=(const FairReadWriteLock&) = delete;
+
+    void readLock() noexcept
+    {
+        for (int spin = 0;; ++spin)
+        {
+            if (tryReadLock())
+            {
+                return;
+            }
+
+            if (spin >= SPIN_COUNT)
+            {
+                uint32_t seq = readerSeq_.load(std::memory_order_seq_cst);
+                if (!readerMayEnter())
+                {
+                    FutexWait(readerSeq_, seq);
+                }
+            }
+        }
+    }
+
+    void readUnlock() noexcept
+    {
+        uint32_t previous = state_.fetch_sub(READER_UNIT, std::memory_order_seq_cst);
+        if (previous == READER_UNIT && waitingWriters_.load(std::memory_order_seq_cst) != 0)
+        {
+            wakeWriter();
+        }
+    }
+
+    bool tryReadLock() noexcept
+    {
+        uint32_t expected = state_.load(std::memory_order_relaxed);
+        while (!(expected & WRITER_BIT) && waitingWriters_.load(std::memory_order_seq_cst) == 0)
+        {
+            if (state_.compare_exchange_weak(expected, expected + READER_UNIT, std::memory_order_seq_cst,
+                                             std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void writeLock() noexcept
+    {
+        if (tryWriteLock())
+        {
+            return;
+        }
+
+        waitingWriters_.fetch_add(1, std::memory_order_seq_cst);
+        for (int spin = 0;; ++spin)
+        {
+            if (tryWriteLock())
+            {
+                break;
+            }
+
+            if (spin >= SPIN_COUNT)
+            {
+                uint32_t seq = writerSeq_.load(std::memory_order_seq_cst);
+                if (state_.load(std::memory_order_seq_cst) != 0)
+                {
+                    FutexWait(writerSeq_, seq);
+                }
+            }
+        }
+        waitingWriters_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    void writeUnlock() noexcept
+    {
+        state_.store(0, std::memory_order_seq_cst);
+        if (waitingWriters_.load(std::memory_order_seq_cst) != 0)
+        {
+            wakeWriter();
+        }
+        else
+        {
+            readerSeq_.fetch_add(1, std::memory_order_seq_cst);
+            FutexWake(readerSeq_);
+        }
+    }
+
+    bool tryWriteLock() noexcept
+    {
+        uint32_t expected = 0;
+        return state_.compare_exchange_strong(expected, WRITER_BIT, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed);
+    }
+
+    bool isLockedForRead() const noexcept
+    {
+        return (state_.load(std::memory_order_acquire) & ~WRITER_BIT) != 0;
+    }
+
+    bool isLockedForWrite() const noexcept
+    {
+        return (state_.load(std::memory_order_acquire) & WRITER_BIT) != 0;
+    }
+
+    uint32_t readerCount() const noexcept
+    {
+        return state_.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    bool readerMayEnter() const noexcept
+    {
+        return !(state_.load(std::memory_order_seq_cst) & WRITER_BIT) &&
+               waitingWriters_.load(std::memory_order_seq_cst) == 0;
+    }
+
+    void wakeWriter() noexcept
+    {
+        writerSeq_.fetch_add(1, std::memory_order_seq_cst);
+        FutexWake(writerSeq_, 1);
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> state_{0};
+    std::atomic<uint32_t> waitingWriters_{0};
+    std::atomic<uint32_t> readerSeq_{0};
+    std::atomic<uint32_t> writerSeq_{0};
+};
+
+using FairReadLockGuard = BasicReadLockGuard<FairReadWriteLock>;
+using FairWriteLockGuard = BasicWriteLockGuard<FairReadWriteLock>;
+
+} // namespace casket
@@ -0,0 +1,27 @@
+#pragma once
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+namespace casket
+{
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit integer");
+
+/// @brief Sleeps while the word still holds the expected value, may return spuriously.
+inline void FutexWait(std::atomic<uint32_t>& word, uint32_t expected) noexcept
+{
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+/// @brief Wakes up to count threads sleeping on the word.
+inline void FutexWake(std::atomic<uint32_t>& word, int count = INT_MAX) noexcept
+{
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+} // namespace casket
@@ -4,7 +4,9 @@
 #include <memory>
 #include <vector>
 #include <functional>
+#include <mutex>
 #include <thread>
+#include <casket/concurrency/thread_slot.hpp>
 
 namespace casket
 {
@@ -85,23 +87,126 @@ private:
     alignas(64) std::atomic<int32_t> readerCounters_[2];
 };
 
-template <typename T>
+/// @brief RCU flavor whose readers only touch a per-thread slot.
+/// @details Every slot holds its own pair of reader counters on a separate cache line, so read-side
+///          critical sections on different threads never share memory. synchronize() flips the epoch and
+///          sums the counters of the previous parity over all slots. Threads beyond the slot count share
+///          slots, which stays correct and only brings back some contention.
+class DistributedRCU final
+{
+public:
+    /// Parity of the epoch in bit 0 and the reader slot in the remaining bits.
+    using Epoch = uint64_t;
+
+    explicit DistributedRCU(size_t slots = DefaultSlotCount())
+        : slots_(RoundUpToPowerOfTwo(slots))
+        , mask_(slots_.size() - 1)
+    {
+    }
+
+    DistributedRCU(const DistributedRCU&) = delete;
+    DistributedRCU& operator=(const DistributedRCU&) = delete;
+
+    Epoch readLock() noexcept
+    {
+        size_t index = CurrentThreadSlot() & mask_;
+        auto& counters = slots_[index].counters;
+
+        while (true)
+        {
+            uint64_t epoch = globalEpoch_.load(std::memory_order_seq_cst);
+            auto parity = static_cast<size_t>(epoch & 1);
+
+            // Pairs with synchronize(): either the writer sees this reader or the reader sees the new epoch.
+            counters[parity].fetch_add(1, std::memory_order_seq_cst);
+            if (globalEpoch_.load(std::memory_order_seq_cst) == epoch)
+            {
+                return (static_cast<Epoch>(index) << 1) | parity;
+            }
+
+            counters[parity].fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void readUnlock(Epoch epoch) noexcept
+    {
+        slots_[epoch >> 1].counters[epoch & 1].fetch_sub(1, std::memory_order_release);
+    }
+
+    /// @brief Waits until every read-side critical section that started before the call has ended.
+    void synchronize() noexcept
+    {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+
+        uint64_t oldEpoch = globalEpoch_.fetch_add(1, std::memory_order_seq_cst);
+        auto parity = static_cast<size_t>(oldEpoch & 1);
+
+        while (hasReaders(parity))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    uint64_t getEpoch() const noexcept
+    {
+        return globalEpoch_.load(std::memory_order_relaxed);
+    }
+
+    size_t slotCount() const noexcept
+    {
+        return slots_.size();
+    }
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<int64_t> counters[2]{};
+    };
+
+    bool hasReaders(size_t parity) const noexcept
+    {
+        for (const auto& slot : slots_)
+        {
+            if (slot.counters[parity].load(std::memory_order_seq_cst) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    alignas(64) std::atomic<uint64_t> globalEpoch_{0};
+    std::vector<Slot> slots_;
+    size_t mask_;
+    std::mutex writerMutex_;
+};
+
+/// @brief Read-side critical section holding a pointer to RCU protected data.
+/// @tparam Domain RCU flavor, RCU or DistributedRCU.
+template <typename T, typename Domain = RCU>
 class RCUReadHandle final
 {
 public:
-    explicit RCUReadHandle(T* data, RCU& rcu)
+    /// @note data is evaluated before the read lock is taken, load it under the lock and use the
+    ///       adopting constructor when the pointer itself is RCU protected.
+    explicit RCUReadHandle(T* data, Domain& rcu)
         : data_(data)
-        , rcu_(rcu)
-        , epoch_(rcu_.readLock())
+        , rcu_(&rcu)
+        , epoch_(rcu_->readLock())
+    {
+    }
+
+    /// @brief Takes ownership of a read lock acquired with rcu.readLock().
+    RCUReadHandle(T* data, Domain& rcu, typename Domain::Epoch epoch, std::adopt_lock_t) noexcept
+        : data_(data)
+        , rcu_(&rcu)
+        , epoch_(epoch)
     {
     }
 
     ~RCUReadHandle()
     {
-        if (data_ != nullptr)
-        {
-            rcu_.readUnlock(epoch_);
-        }
+        reset();
     }
 
     RCUReadHandle(const RCUReadHandle&) = delete;
@@ -109,7 +214,7 @@ public:
 
     RCUReadHandle(RCUReadHandle&& other) noexcept
         : data_(std::exchange(other.data_, nullptr))
-        , rcu_(other.rcu_)
+        , rcu_(std::exchange(other.rcu_, nullptr))
         , epoch_(other.epoch_)
     {
     }
@@ -120,7 +225,7 @@ public:
         {
             reset();
             data_ = std::exchange(other.data_, nullptr);
-            rcu_ = other.rcu_;
+            rcu_ = std::exchange(other.rcu_, nullptr);
             epoch_ = other.epoch_;
         }
         return *this;
@@ -148,17 +253,18 @@ public:
 
     void reset() noexcept
     {
-        if (data_ != nullptr)
+        if (rcu_ != nullptr)
         {
-            rcu_.readUnlock(epoch_);
-            data_ = nullptr;
+            rcu_->readUnlock(epoch_);
+            rcu_ = nullptr;
         }
+        data_ = nullptr;
     }
 
 private:
     T* data_;
-    RCU& rcu_;
-    RCU::Epoch epoch_;
+    Domain* rcu_;
+    typename Domain::Epoch epoch_;
 };
 
 } // namespace casket
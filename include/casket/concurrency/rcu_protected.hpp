@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <casket/concurrency/rcu_reclaimer.hpp>
+
+namespace casket
+{
+
+/// @brief Pointer to an immutable value published with RCU.
+/// @details Readers take a guard that pins the current value without blocking writers. Writers
+///          publish a new value and hand the old one to the reclaimer, so they never wait for readers.
+///          Writers are serialized among themselves, so modify() never copies a value that a concurrent
+///          update() has already retired.
+template <typename T, typename Domain = DistributedRCU>
+class RCUProtected final
+{
+public:
+    using ReadGuard = RCUReadHandle<const T, Domain>;
+
+    RCUProtected(RCUReclaimer<Domain>& reclaimer, std::unique_ptr<T> value)
+        : reclaimer_(reclaimer)
+        , current_(value.release())
+    {
+    }
+
+    /// @brief Deletes the current value, readers must be done with it.
+    ~RCUProtected() noexcept
+    {
+        delete current_.load(std::memory_order_relaxed);
+    }
+
+    RCUProtected(const RCUProtected&) = delete;
+    RCUProtected& operator=(const RCUProtected&) = delete;
+
+    /// @brief Pins the current value until the guard is destroyed.
+    ReadGuard read() const noexcept
+    {
+        Domain& rcu = reclaimer_.domain();
+        // The lock must be taken before the pointer is loaded, otherwise the value may already be retired.
+        auto epoch = rcu.readLock();
+        return ReadGuard(current_.load(std::memory_order_acquire), rcu, epoch, std::adopt_lock);
+    }
+
+    /// @brief Publishes a new value, the previous one is deleted after a grace period.
+    void update(std::unique_ptr<T> value)
+    {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        replace(std::move(value));
+    }
+
+    /// @brief Copies the current value, applies the function to the copy and publishes it.
+    template <typename Function>
+    void modify(Function&& function)
+    {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+
+        const T* current = current_.load(std::memory_order_acquire);
+        auto copy = current ? std::make_unique<T>(*current) : std::make_unique<T>();
+        std::forward<Function>(function)(*copy);
+        replace(std::move(copy));
+    }
+
+private:
+    /// @brief Swaps in the new value and retires the old one, the caller must hold writerMutex_.
+    void replace(std::unique_ptr<T> value)
+    {
+        T* old = current_.exchange(value.release(), std::memory_order_acq_rel);
+        reclaimer_.retire(old);
+    }
+
+    RCUReclaimer<Domain>& reclaimer_;
+    std::atomic<T*> current_;
+    std::mutex writerMutex_;
+};
+
+} // namespace casket
@@ -0,0 +1,137 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <casket/concurrency/rcu.hpp>
+
+namespace casket
+{
+
+/// @brief Runs callbacks after a grace period on a background thread.
+/// @details Writers queue a callback and return immediately. The reclaimer thread takes every queued
+///          callback as one batch, waits for a single grace period and runs the batch, so updates made
+///          while a grace period is in progress share the next one.
+/// @tparam Domain RCU flavor, its synchronize() must be safe to call concurrently with other writers.
+template <typename Domain = DistributedRCU>
+class RCUReclaimer final
+{
+public:
+    using Callback = std::function<void()>;
+
+    explicit RCUReclaimer(Domain& rcu)
+        : rcu_(rcu)
+    {
+        thread_ = std::thread([this] { run(); });
+    }
+
+    /// @brief Stops the thread after running every queued callback.
+    ~RCUReclaimer() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        thread_.join();
+    }
+
+    RCUReclaimer(const RCUReclaimer&) = delete;
+    RCUReclaimer& operator=(const RCUReclaimer&) = delete;
+
+    /// @brief Queues a callback that runs once every reader active at the time of the call has finished.
+    void callRCU(Callback callback)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.push_back(std::move(callback));
+            ++queued_;
+        }
+        condition_.notify_all();
+    }
+
+    /// @brief Deletes the object after a grace period.
+    template <typename T, typename Deleter = std::default_delete<T>>
+    void retire(T* ptr, Deleter deleter = Deleter())
+    {
+        if (ptr != nullptr)
+        {
+            callRCU([ptr, deleter = std::move(deleter)]() mutable { deleter(ptr); });
+        }
+    }
+
+    /// @brief Blocks until every callback queued before the call has run.
+    void barrier()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        uint64_t target = queued_;
+        doneCondition_.wait(lock, [this, target] { return completed_ >= target; });
+    }
+
+    Domain& domain() noexcept
+    {
+        return rcu_;
+    }
+
+    /// @brief Returns the number of grace periods waited for so far.
+    uint64_t gracePeriods() const noexcept
+    {
+        return gracePeriods_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the number of callbacks run so far.
+    uint64_t completed() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return completed_;
+    }
+
+private:
+    void run()
+    {
+        std::vector<Callback> batch;
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while (true)
+        {
+            condition_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+            if (pending_.empty())
+            {
+                break;
+            }
+
+            batch.swap(pending_);
+            lock.unlock();
+
+            rcu_.synchronize();
+            gracePeriods_.fetch_add(1, std::memory_order_relaxed);
+
+            for (auto& callback : batch)
+            {
+                callback();
+            }
+            size_t count = batch.size();
+            batch.clear();
+
+            lock.lock();
+            completed_ += count;
+            doneCondition_.notify_all();
+        }
+    }
+
+private:
+    Domain& rcu_;
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    std::condition_variable doneCondition_;
+    std::vector<Callback> pending_;
+    uint64_t queued_{0};
+    uint64_t completed_{0};
+    std::atomic<uint64_t> gracePeriods_{0};
+    bool stop_{false};
+    std::thread thread_;
+};
+
+} // namespace casket
@@ -2,6 +2,7 @@
 #include <atomic>
 #include <thread>
 #include <cstdint>
+#include <limits>
 
 namespace casket
 {
@@ -148,25 +149,27 @@ public:
     }
 };
 
-class ReadLockGuard final
+/// @brief Scoped shared ownership of any lock with readLock() and readUnlock().
+template <typename Lock>
+class BasicReadLockGuard final
 {
 private:
-    ReadWriteLock* lock_{nullptr};
+    Lock* lock_{nullptr};
 
 public:
-    explicit ReadLockGuard(ReadWriteLock& lock) noexcept
+    explicit BasicReadLockGuard(Lock& lock) noexcept
         : lock_(&lock)
     {
         lock_->readLock();
     }
 
-    ReadLockGuard(ReadLockGuard&& other) noexcept
+    BasicReadLockGuard(BasicReadLockGuard&& other) noexcept
         : lock_(other.lock_)
     {
         other.lock_ = nullptr;
     }
 
-    ReadLockGuard& operator=(ReadLockGuard&& other) noexcept
+    BasicReadLockGuard& operator=(BasicReadLockGuard&& other) noexcept
     {
         if (this != &other)
         {
@@ -177,10 +180,10 @@ public:
         return *this;
     }
 
-    ReadLockGuard(const ReadLockGuard&) = delete;
-    ReadLockGuard& operator=(const ReadLockGuard&) = delete;
+    BasicReadLockGuard(const BasicReadLockGuard&) = delete;
+    BasicReadLockGuard& operator=(const BasicReadLockGuard&) = delete;
 
-    ~ReadLockGuard() noexcept
+    ~BasicReadLockGuard() noexcept
     {
         unlock();
     }
@@ -200,25 +203,27 @@ public:
     }
 };
 
-class WriteLockGuard final
+/// @brief Scoped exclusive ownership of any lock with writeLock() and writeUnlock().
+template <typename Lock>
+class BasicWriteLockGuard final
 {
 private:
-    ReadWriteLock* lock_{nullptr};
+    Lock* lock_{nullptr};
 
 public:
-    explicit WriteLockGuard(ReadWriteLock& lock) noexcept
+    explicit BasicWriteLockGuard(Lock& lock) noexcept
         : lock_(&lock)
     {
         lock_->writeLock();
     }
 
-    WriteLockGuard(WriteLockGuard&& other) noexcept
+    BasicWriteLockGuard(BasicWriteLockGuard&& other) noexcept
         : lock_(other.lock_)
     {
         other.lock_ = nullptr;
     }
 
-    WriteLockGuard& operator=(WriteLockGuard&& other) noexcept
+    BasicWriteLockGuard& operator=(BasicWriteLockGuard&& other) noexcept
     {
         if (this != &other)
         {
@@ -229,10 +234,10 @@ public:
         return *this;
     }
 
-    WriteLockGuard(const WriteLockGuard&) = delete;
-    WriteLockGuard& operator=(const WriteLockGuard&) = delete;
+    BasicWriteLockGuard(const BasicWriteLockGuard&) = delete;
+    BasicWriteLockGuard& operator=(const BasicWriteLockGuard&) = delete;
 
-    ~WriteLockGuard() noexcept
+    ~BasicWriteLockGuard() noexcept
     {
         unlock();
     }
@@ -252,4 +257,7 @@ public:
     }
 };
 
+using ReadLockGuard = BasicReadLockGuard<ReadWriteLock>;
+using WriteLockGuard = BasicWriteLockGuard<ReadWriteLock>;
+
 } // namespace casket
\ No newline at end of file
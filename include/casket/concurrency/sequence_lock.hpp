@@ -1,44 +1,106 @@
 #pragma once
+#include <array>
 #include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
 #include <type_traits>
 
 namespace casket
 {
 
+namespace detail
+{
+
+/// @brief Payload of a sequence lock kept as an array of atomic words.
+/// @details A reader racing with a writer may observe a torn value, so the bytes are copied with relaxed
+///          word-sized atomic operations instead of a plain assignment, which would be a data race.
 template <typename T>
-class SequenceLock
+class SequenceStorage
 {
 public:
-    static_assert(std::is_nothrow_copy_assignable<T>::value, "T must satisfy is_nothrow_copy_assignable");
-    static_assert(std::is_trivially_copy_assignable<T>::value, "T must satisfy is_trivially_copy_assignable");
+    static_assert(std::is_trivially_copyable<T>::value, "T must satisfy is_trivially_copyable");
+    static_assert(std::is_default_constructible<T>::value, "T must satisfy is_default_constructible");
+
+    using Word = uint64_t;
+
+    static constexpr size_t kWords = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+    /// Words copied between sequence checks, so that a reader of a large payload gives up early.
+    static constexpr size_t kChunkWords = 64;
+
+    explicit SequenceStorage(const T& initial) noexcept
+    {
+        write(initial);
+    }
+
+    /// @brief Copies the payload out, returns false as soon as the sequence is seen to differ from seq0.
+    bool read(T& out, const std::atomic<size_t>& seq, size_t seq0) const noexcept
+    {
+        std::array<Word, kWords> buffer;
+        for (size_t begin = 0; begin < kWords; begin += kChunkWords)
+        {
+            size_t end = begin + kChunkWords < kWords ? begin + kChunkWords : kWords;
+            for (size_t i = begin; i < end; ++i)
+            {
+                buffer[i] = words_[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) != seq0)
+            {
+                return false;
+            }
+        }
+
+        std::memcpy(static_cast<void*>(&out), buffer.data(), sizeof(T));
+        return true;
+    }
+
+    void write(const T& value) noexcept
+    {
+        std::array<Word, kWords> buffer{};
+        std::memcpy(buffer.data(), static_cast<const void*>(&value), sizeof(T));
+        for (size_t i = 0; i < kWords; ++i)
+        {
+            words_[i].store(buffer[i], std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::array<std::atomic<Word>, kWords> words_;
+};
+
+} // namespace detail
 
+/// @brief Single-writer sequence lock, readers copy the value and retry if a store overlapped.
+/// @note Only one thread may call store() at a time, use MultiWriterSequenceLock otherwise.
+template <typename T>
+class SequenceLock
+{
+public:
     SequenceLock()
         : seq_(0)
+        , value_(T{})
     {
     }
 
     T load() const noexcept
     {
         T copy;
-        std::size_t seq0, seq1;
+        std::size_t seq0;
         do
         {
             seq0 = seq_.load(std::memory_order_acquire);
-            std::atomic_signal_fence(std::memory_order_acq_rel);
-            copy = value_;
-            std::atomic_signal_fence(std::memory_order_acq_rel);
-            seq1 = seq_.load(std::memory_order_acquire);
-        } while (seq0 != seq1 || seq0 & 1);
+        } while ((seq0 & 1) || !value_.read(copy, seq_, seq0));
         return copy;
     }
 
     void store(const T& desired) noexcept
     {
         std::size_t seq0 = seq_.load(std::memory_order_relaxed);
-        seq_.store(seq0 + 1, std::memory_order_release);
-        std::atomic_signal_fence(std::memory_order_acq_rel);
-        value_ = desired;
-        std::atomic_signal_fence(std::memory_order_acq_rel);
+        seq_.store(seq0 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        value_.write(desired);
         seq_.store(seq0 + 2, std::memory_order_release);
     }
 
@@ -46,12 +108,73 @@ private:
     static const std::size_t kFalseSharingRange = 128;
 
     // Align to prevent false sharing with adjecent data
-    alignas(kFalseSharingRange) T value_;
-    std::atomic<std::size_t> seq_;
-    // Padding to prevent false sharing with adjecent data
-    char padding_[kFalseSharingRange - ((sizeof(value_) + sizeof(seq_)) % kFalseSharingRange)];
-    static_assert(((sizeof(value_) + sizeof(seq_) + sizeof(padding_)) % kFalseSharingRange) == 0,
-                  "sizeof(Seqlock<T>) should be a multiple of kFalseSharingRange");
+    alignas(kFalseSharingRange) std::atomic<std::size_t> seq_;
+    detail::SequenceStorage<T> value_;
+};
+
+/// @brief Sequence lock that accepts concurrent writers.
+/// @details A writer claims the lock by moving the sequence from even to odd with a CAS, so stores are
+///          serialized without a separate mutex. Readers behave exactly as with SequenceLock.
+template <typename T>
+class MultiWriterSequenceLock
+{
+public:
+    MultiWriterSequenceLock()
+        : seq_(0)
+        , value_(T{})
+    {
+    }
+
+    T load() const noexcept
+    {
+        T copy;
+        std::size_t seq0;
+        do
+        {
+            seq0 = seq_.load(std::memory_order_acquire);
+        } while ((seq0 & 1) || !value_.read(copy, seq_, seq0));
+        return copy;
+    }
+
+    void store(const T& desired) noexcept
+    {
+        std::size_t seq0 = lockWrite();
+        value_.write(desired);
+        seq_.store(seq0 + 2, std::memory_order_release);
+    }
+
+    /// @brief Applies fn to the current value and publishes the result, atomically with other writers.
+    template <typename Fn>
+    void update(Fn&& fn)
+    {
+        std::size_t seq0 = lockWrite();
+        T copy;
+        // The value cannot change while the sequence is odd and owned by this writer.
+        value_.read(copy, seq_, seq0 + 1);
+        fn(copy);
+        value_.write(copy);
+        seq_.store(seq0 + 2, std::memory_order_release);
+    }
+
+private:
+    std::size_t lockWrite() noexcept
+    {
+        std::size_t seq0 = seq_.load(std::memory_order_relaxed);
+        while ((seq0 & 1) ||
+               !seq_.compare_exchange_weak(seq0, seq0 + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            std::this_thread::yield();
+            seq0 = seq_.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        return seq0;
+    }
+
+private:
+    static const std::size_t kFalseSharingRange = 128;
+
+    alignas(kFalseSharingRange) std::atomic<std::size_t> seq_;
+    detail::SequenceStorage<T> value_;
 };
 
-} // namespace casket
\ No newline at end of file
+} // namespace casket
@@ -0,0 +1,160 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <casket/concurrency/read_write_lock.hpp>
+#include <casket/concurrency/thread_slot.hpp>
+
+namespace casket
+{
+
+/// @brief Big-reader lock: readers only touch the counter of their own slot.
+/// @details Read lock and unlock cost one uncontended atomic on a cache line private to the thread, so
+///          read-mostly paths scale with cores. A writer raises a flag that stops new readers and then
+///          waits for every slot to drain, which makes writes expensive and proportional to the slot count.
+///          Writers are preferred: readers arriving while a writer waits back off until it is done.
+/// @note A read lock must be released by the thread that acquired it.
+class ShardedReadWriteLock final
+{
+public:
+    explicit ShardedReadWriteLock(size_t slots = DefaultSlotCount())
+        : slots_(RoundUpToPowerOfTwo(slots))
+        , mask_(slots_.size() - 1)
+    {
+    }
+
+    ShardedReadWriteLock(const ShardedReadWriteLock&) = delete;
+    ShardedReadWriteLock& operator=(const ShardedReadWriteLock&) = delete;
+
+    void readLock() noexcept
+    {
+        auto& readers = localSlot().readers;
+
+        while (true)
+        {
+            while (writer_.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            // Pairs with writeLock(): either the writer sees this reader or the reader sees the writer.
+            readers.fetch_add(1, std::memory_order_seq_cst);
+            if (!writer_.load(std::memory_order_seq_cst))
+            {
+                return;
+            }
+            readers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void readUnlock() noexcept
+    {
+        localSlot().readers.fetch_sub(1, std::memory_order_release);
+    }
+
+    bool tryReadLock() noexcept
+    {
+        auto& readers = localSlot().readers;
+        if (writer_.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        readers.fetch_add(1, std::memory_order_seq_cst);
+        if (!writer_.load(std::memory_order_seq_cst))
+        {
+            return true;
+        }
+        readers.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    void writeLock() noexcept
+    {
+        bool expected = false;
+        while (!writer_.compare_exchange_weak(expected, true, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            expected = false;
+            std::this_thread::yield();
+        }
+
+        while (hasReaders())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void writeUnlock() noexcept
+    {
+        writer_.store(false, std::memory_order_release);
+    }
+
+    bool tryWriteLock() noexcept
+    {
+        bool expected = false;
+        if (!writer_.compare_exchange_strong(expected, true, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        if (hasReaders())
+        {
+            writer_.store(false, std::memory_order_release);
+            return false;
+        }
+        return true;
+    }
+
+    bool isLockedForRead() const noexcept
+    {
+        return hasReaders();
+    }
+
+    bool isLockedForWrite() const noexcept
+    {
+        return writer_.load(std::memory_order_acquire) && !hasReaders();
+    }
+
+    uint32_t readerCount() const noexcept
+    {
+        uint32_t count = 0;
+        for (const auto& slot : slots_)
+        {
+            count += slot.readers.load(std::memory_order_acquire);
+        }
+        return count;
+    }
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<uint32_t> readers{0};
+    };
+
+    Slot& localSlot() noexcept
+    {
+        return slots_[CurrentThreadSlot() & mask_];
+    }
+
+    bool hasReaders() const noexcept
+    {
+        for (const auto& slot : slots_)
+        {
+            if (slot.readers.load(std::memory_order_seq_cst) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    alignas(64) std::atomic<bool> writer_{false};
+    std::vector<Slot> slots_;
+    size_t mask_;
+};
+
+using ShardedReadLockGuard = BasicReadLockGuard<ShardedReadWriteLock>;
+using ShardedWriteLockGuard = BasicWriteLockGuard<ShardedReadWriteLock>;
+
+} // namespace casket
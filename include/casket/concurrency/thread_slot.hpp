@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+namespace casket
+{
+
+/// @brief Returns a number assigned to the calling thread on first use, threads are numbered in start order.
+/// @details Sharded structures use it to spread threads over per-slot state without a syscall per access.
+///          Unlike sched_getcpu() the value is stable, so a thread keeps hitting the same cache line.
+inline size_t CurrentThreadSlot() noexcept
+{
+    static std::atomic<size_t> nextSlot{0};
+    thread_local const size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+/// @brief Returns the smallest power of two not below value, so a slot index is a mask away.
+inline size_t RoundUpToPowerOfTwo(size_t value) noexcept
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+/// @brief Returns a power of two slot count that gives every hardware thread its own slot.
+inline size_t DefaultSlotCount() noexcept
+{
+    size_t count = RoundUpToPowerOfTwo(std::thread::hardware_concurrency());
+    return count < 8 ? 8 : count;
+}
+
+} // namespace casket
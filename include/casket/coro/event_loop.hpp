@@ -0,0 +1,352 @@
+#pragma once
+#include <casket/coro/task.hpp>
+
+#if LANGUAGE_HAS_COROUTINES
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <casket/multiplexing/epoll_poller.hpp>
+#include <casket/types/timer_wheel.hpp>
+
+namespace casket
+{
+
+/// @brief Single-threaded epoll loop that resumes coroutines on fd readiness and timers.
+/// @details Attached descriptors are registered once, edge-triggered. An edge that arrives while no
+///          coroutine waits is remembered, so the usual pattern of reading until EAGAIN and then
+///          awaiting readable() never misses a wakeup and costs no epoll_ctl per wait.
+///          Only schedule(), spawn() and stop() may be called from other threads.
+class EventLoop final
+{
+public:
+    using Clock = TimerWheel::Clock;
+
+private:
+    struct ReadinessAwaiter;
+
+    struct FdState
+    {
+        EventType ready{EventType::None};
+        ReadinessAwaiter* reader{nullptr};
+        ReadinessAwaiter* writer{nullptr};
+    };
+
+    struct ReadinessAwaiter
+    {
+        FdState* state;
+        EventType interest;
+        std::coroutine_handle<> handle;
+        EventType result{EventType::Error};
+
+        bool await_ready() noexcept
+        {
+            if (!state)
+            {
+                return true;
+            }
+
+            EventType mask = interest | EventType::Error | EventType::HangUp;
+            if ((state->ready & mask) == EventType::None)
+            {
+                return false;
+            }
+
+            result = state->ready & mask;
+            state->ready = state->ready & ~interest;
+            return true;
+        }
+
+        void await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            handle = awaiting;
+            (interest == EventType::Readable ? state->reader : state->writer) = this;
+        }
+
+        /// @return ready events, Error if the fd is not attached or was detached while waiting.
+        EventType await_resume() const noexcept
+        {
+            return result;
+        }
+    };
+
+    struct SleepAwaiter
+    {
+        EventLoop& loop;
+        Clock::duration delay;
+        TimerWheel::Timer timer{};
+
+        bool await_ready() const noexcept
+        {
+            return delay <= Clock::duration::zero();
+        }
+
+        void await_suspend(std::coroutine_handle<> awaiting)
+        {
+            timer.setCallback([this, awaiting]() { loop.ready_.push_back(awaiting); });
+            loop.timers_.schedule(timer, delay);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    struct ScheduleAwaiter
+    {
+        EventLoop& loop;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> awaiting)
+        {
+            loop.post(awaiting);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+public:
+    EventLoop()
+        : wakeFd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        , events_(kMaxEvents)
+    {
+        if (wakeFd_ < 0)
+        {
+            throw std::system_error(std::error_code(errno, std::system_category()), "Failed to create eventfd");
+        }
+
+        std::error_code ec;
+        poller_.add(wakeFd_, EventType::Readable, ec);
+        if (ec)
+        {
+            ::close(wakeFd_);
+            throw std::system_error(ec, "Failed to register eventfd");
+        }
+    }
+
+    ~EventLoop() noexcept
+    {
+        ::close(wakeFd_);
+    }
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /// @brief Registers a non-blocking descriptor so that it can be awaited.
+    void attach(int fd, std::error_code& ec)
+    {
+        if (fd < 0)
+        {
+            ec = std::make_error_code(std::errc::bad_file_descriptor);
+            return;
+        }
+
+        if (static_cast<size_t>(fd) >= fds_.size())
+        {
+            fds_.resize(fd + 1);
+        }
+
+        auto state = std::make_unique<FdState>();
+        EventType events = EventType::Readable | EventType::Writable | EventType::HangUp | EventType::EdgeTriggered;
+        poller_.add(state.get(), fd, events, ec);
+        if (!ec)
+        {
+            fds_[fd] = std::move(state);
+        }
+    }
+
+    /// @brief Unregisters a descriptor, coroutines waiting on it are resumed with EventType::Error.
+    void detach(int fd, std::error_code& ec)
+    {
+        FdState* state = find(fd);
+        if (!state)
+        {
+            ec = std::make_error_code(std::errc::no_such_file_or_directory);
+            return;
+        }
+
+        poller_.remove(fd, ec);
+        for (ReadinessAwaiter* waiter : {state->reader, state->writer})
+        {
+            if (waiter)
+            {
+                waiter->result = EventType::Error;
+                ready_.push_back(waiter->handle);
+            }
+        }
+        fds_[fd].reset();
+    }
+
+    /// @brief Awaits until the attached descriptor is readable, returns the ready events.
+    [[nodiscard]] ReadinessAwaiter readable(int fd) noexcept
+    {
+        return ReadinessAwaiter{find(fd), EventType::Readable, {}};
+    }
+
+    /// @brief Awaits until the attached descriptor is writable, returns the ready events.
+    [[nodiscard]] ReadinessAwaiter writable(int fd) noexcept
+    {
+        return ReadinessAwaiter{find(fd), EventType::Writable, {}};
+    }
+
+    /// @brief Suspends the awaiting coroutine, it must be running on the loop thread.
+    [[nodiscard]] SleepAwaiter sleepFor(Clock::duration delay) noexcept
+    {
+        return SleepAwaiter{*this, delay};
+    }
+
+    /// @brief Resumes the awaiting coroutine on the loop thread, e.g. after co_await pool.schedule().
+    [[nodiscard]] ScheduleAwaiter schedule() noexcept
+    {
+        return ScheduleAwaiter{*this};
+    }
+
+    /// @brief Starts a task on the loop thread, the loop does not wait for it when stopping.
+    /// @details An exception escaping the task terminates the program, as it would for std::thread.
+    void spawn(Task<void> task)
+    {
+        Spawn(*this, std::move(task)).start();
+    }
+
+    TimerWheel& getTimers() noexcept
+    {
+        return timers_;
+    }
+
+    /// @brief Runs the loop until stop() is called.
+    void run()
+    {
+        while (!stopped_.load(std::memory_order_acquire))
+        {
+            std::error_code ec;
+            runOnce(-1, ec);
+            if (ec && ec != std::errc::interrupted)
+            {
+                throw std::system_error(ec, "EventLoop wait failed");
+            }
+        }
+        stopped_.store(false, std::memory_order_relaxed);
+    }
+
+    /// @brief Waits for events once and resumes every coroutine that became ready.
+    /// @param[in] timeoutMs maximum wait when nothing is ready, -1 waits for an event or a timer.
+    void runOnce(int timeoutMs, std::error_code& ec)
+    {
+        int count = poller_.wait(events_.data(), kMaxEvents, timers_, ready_.empty() ? timeoutMs : 0, ec);
+
+        for (int i = 0; i < count; ++i)
+        {
+            const auto& event = events_[i];
+            if (event.fd == wakeFd_)
+            {
+                drainRemote();
+            }
+            else if (event.userData)
+            {
+                dispatch(*static_cast<FdState*>(event.userData), event.revents);
+            }
+        }
+
+        // Coroutines resumed here may make others ready, those run on the next iteration.
+        running_.swap(ready_);
+        for (auto handle : running_)
+        {
+            handle.resume();
+        }
+        running_.clear();
+    }
+
+    /// @brief Makes run() return after the current iteration, may be called from any thread.
+    void stop() noexcept
+    {
+        stopped_.store(true, std::memory_order_release);
+        wake();
+    }
+
+private:
+    static constexpr int kMaxEvents = 64;
+
+    static detail::DetachedTask Spawn(EventLoop& loop, Task<void> task)
+    {
+        co_await loop.schedule();
+        co_await std::move(task);
+    }
+
+    FdState* find(int fd) const noexcept
+    {
+        return fd >= 0 && static_cast<size_t>(fd) < fds_.size() ? fds_[fd].get() : nullptr;
+    }
+
+    void dispatch(FdState& state, EventType revents)
+    {
+        state.ready |= revents;
+        wakeWaiter(state.reader);
+        wakeWaiter(state.writer);
+    }
+
+    void wakeWaiter(ReadinessAwaiter*& waiter)
+    {
+        if (waiter && waiter->await_ready())
+        {
+            ready_.push_back(waiter->handle);
+            waiter = nullptr;
+        }
+    }
+
+    void post(std::coroutine_handle<> handle)
+    {
+        bool wasEmpty;
+        {
+            std::lock_guard<std::mutex> lock(remoteMutex_);
+            wasEmpty = remote_.empty();
+            remote_.push_back(handle);
+        }
+
+        if (wasEmpty)
+        {
+            wake();
+        }
+    }
+
+    void wake() noexcept
+    {
+        uint64_t one = 1;
+        [[maybe_unused]] auto ret = ::write(wakeFd_, &one, sizeof(one));
+    }
+
+    void drainRemote()
+    {
+        uint64_t value;
+        [[maybe_unused]] auto ret = ::read(wakeFd_, &value, sizeof(value));
+
+        std::lock_guard<std::mutex> lock(remoteMutex_);
+        ready_.insert(ready_.end(), remote_.begin(), remote_.end());
+        remote_.clear();
+    }
+
+private:
+    EpollPoller poller_;
+    TimerWheel timers_;
+    int wakeFd_;
+    std::vector<PollEvent> events_;
+    std::vector<std::unique_ptr<FdState>> fds_;
+    std::vector<std::coroutine_handle<>> ready_;
+    std::vector<std::coroutine_handle<>> running_;
+    std::mutex remoteMutex_;
+    std::vector<std::coroutine_handle<>> remote_;
+    std::atomic<bool> stopped_{false};
+};
+
+} // namespace casket
+
+#endif // LANGUAGE_HAS_COROUTINES
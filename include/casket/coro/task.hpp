@@ -0,0 +1,660 @@
+#pragma once
+#include <casket/predefined/language.h>
+
+#if LANGUAGE_HAS_COROUTINES
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace casket
+{
+
+template <typename T = void>
+class Task;
+
+namespace detail
+{
+
+class TaskPromiseBase
+{
+public:
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        // Symmetric transfer: resuming the awaiting coroutine does not grow the stack.
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            return handle.promise().continuation_;
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception() noexcept
+    {
+        exception_ = std::current_exception();
+    }
+
+    void setContinuation(std::coroutine_handle<> continuation) noexcept
+    {
+        continuation_ = continuation;
+    }
+
+protected:
+    void rethrowIfFailed() const
+    {
+        if (exception_)
+        {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+private:
+    std::coroutine_handle<> continuation_{std::noop_coroutine()};
+    std::exception_ptr exception_;
+};
+
+template <typename T>
+class TaskPromise final : public TaskPromiseBase
+{
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+    {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    T& result() &
+    {
+        rethrowIfFailed();
+        return *value_;
+    }
+
+    T&& result() &&
+    {
+        rethrowIfFailed();
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template <>
+class TaskPromise<void> final : public TaskPromiseBase
+{
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept
+    {
+    }
+
+    void result() const
+    {
+        rethrowIfFailed();
+    }
+};
+
+} // namespace detail
+
+/// @brief Lazily started coroutine producing a value of type T.
+/// @details The body runs when the task is awaited and resumes the awaiting coroutine through symmetric
+///          transfer, so long chains of nested tasks run in constant stack space. Exceptions escaping the
+///          body are rethrown to the awaiter.
+template <typename T>
+class [[nodiscard]] Task final
+{
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using value_type = T;
+
+private:
+    struct AwaiterBase
+    {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept
+        {
+            return !handle || handle.done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            handle.promise().setContinuation(awaiting);
+            return handle;
+        }
+    };
+
+public:
+    Task() noexcept = default;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle)
+    {
+    }
+
+    Task(Task&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr))
+    {
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() noexcept
+    {
+        destroy();
+    }
+
+    bool isValid() const noexcept
+    {
+        return handle_ != nullptr;
+    }
+
+    bool isReady() const noexcept
+    {
+        return !handle_ || handle_.done();
+    }
+
+    auto operator co_await() & noexcept
+    {
+        struct Awaiter : AwaiterBase
+        {
+            decltype(auto) await_resume()
+            {
+                return this->handle.promise().result();
+            }
+        };
+        return Awaiter{{handle_}};
+    }
+
+    auto operator co_await() && noexcept
+    {
+        struct Awaiter : AwaiterBase
+        {
+            decltype(auto) await_resume()
+            {
+                return std::move(this->handle.promise()).result();
+            }
+        };
+        return Awaiter{{handle_}};
+    }
+
+private:
+    void destroy() noexcept
+    {
+        if (handle_)
+        {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail
+{
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/// Notified when a detached coroutine finishes, returns the coroutine to resume next.
+class Completion
+{
+public:
+    virtual std::coroutine_handle<> complete() noexcept = 0;
+
+protected:
+    ~Completion() = default;
+};
+
+/// Fire-and-forget coroutine that destroys its own frame once it finishes.
+class DetachedTask final
+{
+public:
+    class promise_type final
+    {
+    public:
+        DetachedTask get_return_object() noexcept
+        {
+            return DetachedTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        auto final_suspend() const noexcept
+        {
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+                {
+                    // Complete first, the frame may hold the last reference to the completion.
+                    Completion* completion = handle.promise().completion_;
+                    auto next = completion ? completion->complete() : std::noop_coroutine();
+                    handle.destroy();
+                    return next;
+                }
+
+                void await_resume() const noexcept
+                {
+                }
+            };
+            return FinalAwaiter{};
+        }
+
+        void return_void() const noexcept
+        {
+        }
+
+        // Detached bodies catch what they want to report, anything else is a bug like in std::thread.
+        [[noreturn]] void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+
+    private:
+        friend class DetachedTask;
+        Completion* completion_{nullptr};
+    };
+
+    explicit DetachedTask(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle)
+    {
+    }
+
+    /// @brief Runs the coroutine until its first suspension point, after that it owns itself.
+    void start(Completion* completion = nullptr) noexcept
+    {
+        handle_.promise().completion_ = completion;
+        std::exchange(handle_, nullptr).resume();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename T>
+struct TaskResult
+{
+    std::optional<T> value;
+    std::exception_ptr exception;
+
+    T get() &&
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskResult<void>
+{
+    std::exception_ptr exception;
+
+    void get() &&
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+template <typename T>
+DetachedTask MakeDetachedTask(Task<T> task, TaskResult<T>& result)
+{
+    try
+    {
+        if constexpr (std::is_void_v<T>)
+        {
+            co_await std::move(task);
+        }
+        else
+        {
+            result.value.emplace(co_await std::move(task));
+        }
+    }
+    catch (...)
+    {
+        result.exception = std::current_exception();
+    }
+}
+
+class SyncWaitEvent final : public Completion
+{
+public:
+    std::coroutine_handle<> complete() noexcept override
+    {
+        // Notify under the lock, the waiter owns the event and destroys it as soon as it wakes up.
+        std::lock_guard<std::mutex> lock(mutex_);
+        set_ = true;
+        condition_.notify_one();
+        return std::noop_coroutine();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return set_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool set_{false};
+};
+
+/// Resumes the awaiting coroutine once every child and the starter itself have arrived.
+class WhenAllLatch final : public Completion
+{
+public:
+    explicit WhenAllLatch(size_t count) noexcept
+        : count_(count + 1)
+    {
+    }
+
+    std::coroutine_handle<> complete() noexcept override
+    {
+        if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            return awaiting_;
+        }
+        return std::noop_coroutine();
+    }
+
+    /// @return false if every child already finished and the awaiting coroutine must not suspend.
+    bool arrive(std::coroutine_handle<> awaiting) noexcept
+    {
+        awaiting_ = awaiting;
+        return count_.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+private:
+    std::atomic<size_t> count_;
+    std::coroutine_handle<> awaiting_;
+};
+
+struct WhenAllAwaiter
+{
+    WhenAllLatch& latch;
+    std::vector<DetachedTask>& children;
+
+    bool await_ready() const noexcept
+    {
+        return children.empty();
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        for (auto& child : children)
+        {
+            child.start(&latch);
+        }
+        return latch.arrive(awaiting);
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+};
+
+template <typename T>
+struct WhenAnyState final : public Completion
+{
+    explicit WhenAnyState(size_t count)
+        : results(count)
+    {
+    }
+
+    // Only the first finished child arrives at the gate, the others just release the state.
+    std::coroutine_handle<> complete() noexcept override
+    {
+        if (finished.fetch_add(1, std::memory_order_acq_rel) == 0)
+        {
+            return arrive();
+        }
+        return std::noop_coroutine();
+    }
+
+    std::coroutine_handle<> arrive() noexcept
+    {
+        if (gate.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            return awaiting;
+        }
+        return std::noop_coroutine();
+    }
+
+    std::vector<TaskResult<T>> results;
+    std::atomic<size_t> winner{SIZE_MAX};
+    std::atomic<size_t> finished{0};
+    std::atomic<int> gate{2}; ///< The first finished child and the starter.
+    std::coroutine_handle<> awaiting;
+};
+
+template <typename T>
+DetachedTask MakeWhenAnyTask(Task<T> task, std::shared_ptr<WhenAnyState<T>> state, size_t index)
+{
+    auto& result = state->results[index];
+    try
+    {
+        if constexpr (std::is_void_v<T>)
+        {
+            co_await std::move(task);
+        }
+        else
+        {
+            result.value.emplace(co_await std::move(task));
+        }
+    }
+    catch (...)
+    {
+        result.exception = std::current_exception();
+    }
+
+    size_t none = SIZE_MAX;
+    state->winner.compare_exchange_strong(none, index, std::memory_order_acq_rel);
+}
+
+} // namespace detail
+
+/// @brief Blocks the calling thread until the task completes and returns its result.
+/// @details Intended for main() and tests; never call it from a coroutine or an event-loop thread.
+template <typename T>
+T SyncWait(Task<T> task)
+{
+    detail::TaskResult<T> result;
+    detail::SyncWaitEvent event;
+
+    detail::MakeDetachedTask(std::move(task), result).start(&event);
+    event.wait();
+
+    return std::move(result).get();
+}
+
+/// @brief Runs every task concurrently and resumes once all of them completed.
+/// @details Children start on the awaiting thread and run until their first suspension, e.g. a
+///          co_await pool.schedule(). The first exception is rethrown after every child finished.
+template <typename T>
+Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> WhenAll(std::vector<Task<T>> tasks)
+{
+    std::vector<detail::TaskResult<T>> results(tasks.size());
+    std::vector<detail::DetachedTask> children;
+    children.reserve(tasks.size());
+
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+        children.push_back(detail::MakeDetachedTask(std::move(tasks[i]), results[i]));
+    }
+
+    detail::WhenAllLatch latch(children.size());
+    co_await detail::WhenAllAwaiter{latch, children};
+
+    if constexpr (std::is_void_v<T>)
+    {
+        for (auto& result : results)
+        {
+            std::move(result).get();
+        }
+    }
+    else
+    {
+        std::vector<T> values;
+        values.reserve(results.size());
+        for (auto& result : results)
+        {
+            values.push_back(std::move(result).get());
+        }
+        co_return values;
+    }
+}
+
+/// @brief Runs tasks of different types concurrently and returns their results as a tuple.
+template <typename... Ts>
+Task<std::tuple<Ts...>> WhenAll(Task<Ts>... tasks)
+{
+    static_assert((!std::is_void_v<Ts> && ...), "use the vector overload for Task<void>");
+
+    std::tuple<detail::TaskResult<Ts>...> results;
+    std::vector<detail::DetachedTask> children;
+    children.reserve(sizeof...(Ts));
+
+    std::apply([&](auto&... result) { (children.push_back(detail::MakeDetachedTask(std::move(tasks), result)), ...); },
+               results);
+
+    detail::WhenAllLatch latch(children.size());
+    co_await detail::WhenAllAwaiter{latch, children};
+
+    co_return std::apply([](auto&... result) { return std::tuple<Ts...>(std::move(result).get()...); }, results);
+}
+
+template <typename T>
+struct WhenAnyResult
+{
+    size_t index;
+    T value;
+};
+
+template <>
+struct WhenAnyResult<void>
+{
+    size_t index;
+};
+
+/// @brief Runs every task concurrently and resumes as soon as the first one completes.
+/// @details The remaining tasks are not cancelled, they keep running to completion and their results
+///          are discarded. Pass a CancellationToken into them to stop them early.
+template <typename T>
+Task<WhenAnyResult<T>> WhenAny(std::vector<Task<T>> tasks)
+{
+    if (tasks.empty())
+    {
+        throw std::invalid_argument("WhenAny: no tasks");
+    }
+
+    auto state = std::make_shared<detail::WhenAnyState<T>>(tasks.size());
+
+    struct Awaiter
+    {
+        std::shared_ptr<detail::WhenAnyState<T>>& state;
+        std::vector<Task<T>>& tasks;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaiting)
+        {
+            state->awaiting = awaiting;
+            for (size_t i = 0; i < tasks.size(); ++i)
+            {
+                detail::MakeWhenAnyTask(std::move(tasks[i]), state, i).start(state.get());
+            }
+            return state->gate.fetch_sub(1, std::memory_order_acq_rel) != 1;
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    co_await Awaiter{state, tasks};
+
+    size_t index = state->winner.load(std::memory_order_acquire);
+    if constexpr (std::is_void_v<T>)
+    {
+        std::move(state->results[index]).get();
+        co_return WhenAnyResult<void>{index};
+    }
+    else
+    {
+        co_return WhenAnyResult<T>{index, std::move(state->results[index]).get()};
+    }
+}
+
+} // namespace casket
+
+#endif // LANGUAGE_HAS_COROUTINES
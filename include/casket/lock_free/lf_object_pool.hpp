@@ -3,6 +3,7 @@
 #include <atomic>
 #include <vector>
 #include <cassert>
+#include <cstdint>
 #include <stdexcept>
 #include <new>
 
@@ -120,19 +121,17 @@ public:
 
     void release(T* obj) noexcept
     {
-        if (!obj)
+        if (!obj || nodes_.empty())
             return;
 
-        for (size_t i = 0; i < nodes_.size(); ++i)
-        {
-            if (&nodes_[i].obj == obj)
-            {
-                CountedNodePtr ptr(static_cast<int>(i));
-                reclaim(ptr);
-                activeCount_.fetch_sub(1, std::memory_order_relaxed);
-                return;
-            }
-        }
+        // Objects sit at the same offset of consecutive nodes, so the index follows from the address.
+        auto offset = reinterpret_cast<uintptr_t>(obj) - reinterpret_cast<uintptr_t>(&nodes_.front().obj);
+        size_t i = offset / sizeof(Node);
+        if (offset % sizeof(Node) != 0 || i >= nodes_.size())
+            return;
+
+        reclaim(CountedNodePtr(static_cast<int>(i)));
+        activeCount_.fetch_sub(1, std::memory_order_relaxed);
     }
 
     size_t size() const noexcept
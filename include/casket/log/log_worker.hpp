@@ -2,7 +2,9 @@
 #include <thread>
 #include <memory>
 #include <vector>
+#include <type_traits>
 #include <casket/log/async_logger.hpp>
+#include <casket/thread/placement.hpp>
 
 namespace casket
 {
@@ -14,6 +16,8 @@ private:
     std::vector<std::unique_ptr<LogSink>> sinks_;
     std::thread workerThread_;
     std::atomic<bool> running_{true};
+    thread::ThreadPlacement placement_;
+    std::error_code placementError_;
 
     LogRecord batch_[BatchSize];
 
@@ -31,7 +35,15 @@ public:
         workerThread_ = std::thread([this]() { run(); });
     }
 
-    template <typename... Sinks>
+    LogWorker(thread::ThreadPlacement placement, std::vector<std::unique_ptr<LogSink>> sinks)
+        : sinks_(std::move(sinks))
+        , placement_(std::move(placement))
+    {
+        workerThread_ = std::thread([this]() { run(); });
+    }
+
+    template <typename... Sinks,
+              typename = std::enable_if_t<(std::is_convertible_v<Sinks&&, std::unique_ptr<LogSink>> && ...)>>
     explicit LogWorker(Sinks&&... sinks)
     {
         sinks_.reserve(sizeof...(sinks));
@@ -52,9 +64,21 @@ public:
         running_ = false;
     }
 
+    /// @brief Returns the error reported while applying the thread placement.
+    /// @note Valid once the worker thread has been joined.
+    std::error_code getPlacementError() const noexcept
+    {
+        return placementError_;
+    }
+
 private:
     void run()
     {
+        if (!placement_.empty())
+        {
+            thread::ApplyThreadPlacement(placement_, 0, placementError_);
+        }
+
         auto& queue = AsyncLogger::getInstance().buffer_;
         while (running_)
         {
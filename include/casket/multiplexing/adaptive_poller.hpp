@@ -0,0 +1,91 @@
+#pragma once
+
+#include <memory>
+#include <casket/multiplexing/epoll_poller.hpp>
+#include <casket/multiplexing/io_uring_poller.hpp>
+
+namespace casket
+{
+
+enum class PollerBackend
+{
+    Epoll,  ///< Always epoll.
+    IoUring ///< io_uring when the kernel supports it, epoll otherwise.
+};
+
+/// @brief Poller that selects its backend at runtime.
+/// @details Lets servers opt into io_uring without a template parameter and keep working on kernels
+///          without it. getIoUring() exposes the completion-based API when io_uring is active.
+class AdaptivePoller final : public PollerBase<AdaptivePoller>
+{
+public:
+    explicit AdaptivePoller(PollerBackend backend = PollerBackend::Epoll)
+    {
+        if (backend == PollerBackend::IoUring && IoUringPoller::isSupported())
+        {
+            uring_ = std::make_unique<IoUringPoller>();
+        }
+        else
+        {
+            epoll_ = std::make_unique<EpollPoller>();
+        }
+    }
+
+    /// @brief Returns the backend actually in use.
+    PollerBackend backend() const noexcept
+    {
+        return uring_ ? PollerBackend::IoUring : PollerBackend::Epoll;
+    }
+
+    /// @brief Returns the io_uring backend, nullptr when running on epoll.
+    IoUringPoller* getIoUring() noexcept
+    {
+        return uring_.get();
+    }
+
+    void addImpl(int fd, EventType events, std::error_code& ec) noexcept
+    {
+        uring_ ? uring_->add(fd, events, ec) : epoll_->add(fd, events, ec);
+    }
+
+    void addPtrImpl(void* ptr, int fd, EventType events, std::error_code& ec) noexcept
+    {
+        uring_ ? uring_->add(ptr, fd, events, ec) : epoll_->add(ptr, fd, events, ec);
+    }
+
+    void modifyImpl(int fd, EventType events, std::error_code& ec) noexcept
+    {
+        uring_ ? uring_->modify(fd, events, ec) : epoll_->modify(fd, events, ec);
+    }
+
+    void modifyPtrImpl(void* ptr, int fd, EventType events, std::error_code& ec) noexcept
+    {
+        uring_ ? uring_->modify(ptr, fd, events, ec) : epoll_->modify(ptr, fd, events, ec);
+    }
+
+    void removeImpl(int fd, std::error_code& ec) noexcept
+    {
+        uring_ ? uring_->remove(fd, ec) : epoll_->remove(fd, ec);
+    }
+
+    int waitImpl(PollEvent* events, int maxCount, int timeoutMs, std::error_code& ec) noexcept
+    {
+        return uring_ ? uring_->wait(events, maxCount, timeoutMs, ec) : epoll_->wait(events, maxCount, timeoutMs, ec);
+    }
+
+    bool isValidImpl() const noexcept
+    {
+        return uring_ ? uring_->isValid() : epoll_->isValid();
+    }
+
+    void destroyImpl() noexcept
+    {
+        uring_ ? uring_->destroy() : epoll_->destroy();
+    }
+
+private:
+    std::unique_ptr<EpollPoller> epoll_;
+    std::unique_ptr<IoUringPoller> uring_;
+};
+
+} // namespace casket
@@ -60,7 +60,7 @@ public:
 
 using DirectContext = ConnectionContext<DirectMemoryPolicy<ContextData>>;
 
-using PoolContext = ConnectionContext<PoolMemoryPolicy<ContextData, 10000>>;
+using PoolContext = ConnectionContext<PoolMemoryPolicy<ContextData>>;
 
 using VectorContext = ConnectionContext<VectorMemoryPolicy<ContextData>>;
 
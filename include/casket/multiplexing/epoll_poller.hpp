@@ -2,7 +2,9 @@
 
 #include <sys/epoll.h>
 #include <unistd.h>
+#include <algorithm>
 #include <casket/multiplexing/connection_context.hpp>
+#include <casket/multiplexing/fd_table.hpp>
 
 namespace casket
 {
@@ -14,21 +16,25 @@ private:
     using Context = typename ContextManager::Context;
     using ContextPtr = typename ContextManager::ContextPtr;
 
-    static constexpr size_t MAX_CONNECTIONS = 10000;
     static constexpr int MAX_EVENTS = 64;
+    static constexpr int SHRINK_AFTER_WAITS = 64;
 
     int epollFd_;
-    std::array<ContextPtr, MAX_CONNECTIONS> fdToContext_;
+    FdTable<ContextPtr> fdToContext_;
     std::vector<epoll_event> epollEvents_;
     ContextManager contextManager_;
+    int minEvents_;
+    int sparseWaits_{0};
 
 public:
-    EpollPollerTemplate()
+    /// @param[in] initialEvents initial and minimum size of the internal event buffer. The buffer doubles,
+    ///            up to the maxCount given to wait(), whenever a wait fills it, and halves again after a
+    ///            run of waits that use less than a quarter of it.
+    explicit EpollPollerTemplate(int initialEvents = MAX_EVENTS)
         : epollFd_(epoll_create1(0))
-        , epollEvents_(MAX_EVENTS)
+        , epollEvents_(initialEvents > 0 ? initialEvents : MAX_EVENTS)
+        , minEvents_(static_cast<int>(epollEvents_.size()))
     {
-        fdToContext_.fill(nullptr);
-
         if (epollFd_ < 0)
         {
             throw std::system_error(std::error_code(errno, std::system_category()), "Failed to create epoll");
@@ -48,9 +54,11 @@ public:
         , fdToContext_(std::move(other.fdToContext_))
         , epollEvents_(std::move(other.epollEvents_))
         , contextManager_(std::move(other.contextManager_))
+        , minEvents_(other.minEvents_)
+        , sparseWaits_(other.sparseWaits_)
     {
         other.epollFd_ = -1;
-        other.fdToContext_.fill(nullptr);
+        other.fdToContext_.clear();
     }
 
     EpollPollerTemplate& operator=(EpollPollerTemplate&& other) noexcept
@@ -62,8 +70,10 @@ public:
             fdToContext_ = std::move(other.fdToContext_);
             epollEvents_ = std::move(other.epollEvents_);
             contextManager_ = std::move(other.contextManager_);
+            minEvents_ = other.minEvents_;
+            sparseWaits_ = other.sparseWaits_;
             other.epollFd_ = -1;
-            other.fdToContext_.fill(nullptr);
+            other.fdToContext_.clear();
         }
         return *this;
     }
@@ -76,18 +86,25 @@ public:
     void clearContexts()
     {
         contextManager_.clear();
-        fdToContext_.fill(nullptr);
+        fdToContext_.clear();
     }
 
     void addImpl(int fd, EventType events, std::error_code& ec) noexcept
     {
-        if (fd < 0 || fd >= static_cast<int>(MAX_CONNECTIONS))
+        if (fd < 0)
         {
             ec = std::make_error_code(std::errc::invalid_argument);
             return;
         }
 
-        if (fdToContext_[fd] != nullptr)
+        ContextPtr* entry = fdToContext_.acquire(fd);
+        if (!entry)
+        {
+            ec = std::make_error_code(std::errc::not_enough_memory);
+            return;
+        }
+
+        if (*entry != nullptr)
         {
             ec = std::make_error_code(std::errc::file_exists);
             return;
@@ -115,31 +132,31 @@ public:
             return;
         }
 
-        fdToContext_[fd] = ctx;
+        *entry = ctx;
         ec.clear();
     }
 
     void addPtrImpl(void* ptr, int fd, EventType events, std::error_code& ec) noexcept
     {
         addImpl(fd, events, ec);
-        if (!ec && fdToContext_[fd])
+        if (!ec)
         {
-            fdToContext_[fd]->userData = ptr;
+            (*fdToContext_.find(fd))->userData = ptr;
         }
     }
 
     void modifyImpl(int fd, EventType events, std::error_code& ec) noexcept
     {
-        if (fd < 0 || fd >= static_cast<int>(MAX_CONNECTIONS))
+        ContextPtr ctx = find(fd, ec);
+        if (!ctx)
         {
-            ec = std::make_error_code(std::errc::invalid_argument);
             return;
         }
 
-        ContextPtr ctx = fdToContext_[fd];
-        if (!ctx)
+        // An unchanged interest set needs no system call, unless a one-shot registration is re-armed.
+        if (ctx->registeredEvents == events && (events & EventType::OneShot) == EventType::None)
         {
-            ec = std::make_error_code(std::errc::no_such_file_or_directory);
+            ec.clear();
             return;
         }
 
@@ -162,24 +179,17 @@ public:
     void modifyPtrImpl(void* ptr, int fd, EventType events, std::error_code& ec) noexcept
     {
         modifyImpl(fd, events, ec);
-        if (!ec && fdToContext_[fd])
+        if (!ec)
         {
-            fdToContext_[fd]->userData = ptr;
+            (*fdToContext_.find(fd))->userData = ptr;
         }
     }
 
     void removeImpl(int fd, std::error_code& ec) noexcept
     {
-        if (fd < 0 || fd >= static_cast<int>(MAX_CONNECTIONS))
-        {
-            ec = std::make_error_code(std::errc::invalid_argument);
-            return;
-        }
-
-        ContextPtr ctx = fdToContext_[fd];
+        ContextPtr ctx = find(fd, ec);
         if (!ctx)
         {
-            ec = std::make_error_code(std::errc::no_such_file_or_directory);
             return;
         }
 
@@ -190,18 +200,20 @@ public:
         }
 
         contextManager_.destroy(ctx);
-        fdToContext_[fd] = nullptr;
+        *fdToContext_.find(fd) = nullptr;
         ec.clear();
     }
 
     int waitImpl(PollEvent* events, int maxCount, int timeoutMs, std::error_code& ec) noexcept
     {
-        if (maxCount > MAX_EVENTS)
+        if (maxCount <= 0)
         {
-            maxCount = MAX_EVENTS;
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return -1;
         }
 
-        int ret = epoll_wait(epollFd_, epollEvents_.data(), maxCount, timeoutMs);
+        int capacity = std::min(maxCount, static_cast<int>(epollEvents_.size()));
+        int ret = epoll_wait(epollFd_, epollEvents_.data(), capacity, timeoutMs);
 
         if (ret < 0)
         {
@@ -209,6 +221,8 @@ public:
             return -1;
         }
 
+        // Stale entries are dropped, the reported events stay contiguous.
+        int count = 0;
         for (int i = 0; i < ret; ++i)
         {
             const auto& epollEv = epollEvents_[i];
@@ -219,14 +233,24 @@ public:
                 continue;
             }
 
-            events[i].fd = ctx->fd;
-            events[i].userData = ctx->userData;
-            events[i].events = ctx->registeredEvents;
-            events[i].revents = convertEpollToEvents(epollEv.events);
+            PollEvent& event = events[count++];
+            event.fd = ctx->fd;
+            event.userData = ctx->userData;
+            event.events = ctx->registeredEvents;
+            event.revents = convertEpollToEvents(epollEv.events);
+            event.data = nullptr;
+            event.result = 0;
         }
 
+        resizeEvents(ret, capacity, maxCount);
         ec.clear();
-        return ret;
+        return count;
+    }
+
+    /// @brief Current size of the internal event buffer.
+    size_t eventCapacity() const noexcept
+    {
+        return epollEvents_.size();
     }
 
     bool isValidImpl() const noexcept
@@ -238,14 +262,16 @@ public:
     {
         if (epollFd_ != -1)
         {
-            for (size_t i = 0; i < MAX_CONNECTIONS; ++i)
-            {
-                if (fdToContext_[i])
+            fdToContext_.forEach(
+                [this](int, ContextPtr& ctx)
                 {
-                    contextManager_.destroy(fdToContext_[i]);
-                    fdToContext_[i] = nullptr;
-                }
-            }
+                    if (ctx)
+                    {
+                        contextManager_.destroy(ctx);
+                        ctx = nullptr;
+                    }
+                });
+            fdToContext_.clear();
             ::close(epollFd_);
             epollFd_ = -1;
         }
@@ -265,6 +291,10 @@ public:
             result |= EPOLLHUP | EPOLLRDHUP;
         if ((events & EventType::EdgeTriggered) != EventType::None)
             result |= EPOLLET;
+        if ((events & EventType::OneShot) != EventType::None)
+            result |= EPOLLONESHOT;
+        if ((events & EventType::Exclusive) != EventType::None)
+            result |= EPOLLEXCLUSIVE;
         return result;
     }
 
@@ -281,6 +311,61 @@ public:
             result |= EventType::HangUp;
         return result;
     }
+
+private:
+    void resizeEvents(int ret, int capacity, int maxCount) noexcept
+    {
+        int size = static_cast<int>(epollEvents_.size());
+        int target = size;
+
+        if (ret == capacity && size < maxCount)
+        {
+            target = size > maxCount / 2 ? maxCount : size * 2;
+            sparseWaits_ = 0;
+        }
+        else if (ret < size / 4 && size > minEvents_)
+        {
+            if (++sparseWaits_ >= SHRINK_AFTER_WAITS)
+            {
+                target = std::max(size / 2, minEvents_);
+                sparseWaits_ = 0;
+            }
+        }
+        else
+        {
+            sparseWaits_ = 0;
+        }
+
+        if (target != size)
+        {
+            try
+            {
+                epollEvents_.resize(static_cast<size_t>(target));
+                epollEvents_.shrink_to_fit();
+            }
+            catch (const std::bad_alloc&)
+            {
+                // Keep the current buffer.
+            }
+        }
+    }
+
+    ContextPtr find(int fd, std::error_code& ec) noexcept
+    {
+        if (fd < 0)
+        {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return nullptr;
+        }
+
+        ContextPtr* entry = fdToContext_.find(fd);
+        if (!entry || !*entry)
+        {
+            ec = std::make_error_code(std::errc::no_such_file_or_directory);
+            return nullptr;
+        }
+        return *entry;
+    }
 };
 
 using EpollPoller = EpollPollerTemplate<DirectContext>;
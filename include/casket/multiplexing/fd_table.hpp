@@ -0,0 +1,158 @@
+#pragma once
+
+#include <sys/resource.h>
+
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace casket
+{
+
+/// @brief Table indexed by file descriptor, allocated lazily in page-sized chunks.
+/// @details The chunk directory is sized from the RLIMIT_NOFILE soft limit and grows if a larger
+///          descriptor shows up, e.g. after the limit was raised. Only chunks that ever held an entry
+///          are allocated, so sparse or small descriptor sets cost a few pages however high the limit.
+///          Entries are value-initialized, a default T means "no entry".
+template <typename T>
+class FdTable final
+{
+public:
+    static constexpr size_t kChunkEntries = sizeof(T) >= 4096 ? 1 : 4096 / sizeof(T);
+
+    explicit FdTable(size_t capacity = defaultCapacity())
+        : directory_((capacity + kChunkEntries - 1) / kChunkEntries)
+    {
+    }
+
+    FdTable(FdTable&&) noexcept = default;
+    FdTable& operator=(FdTable&&) noexcept = default;
+
+    FdTable(const FdTable&) = delete;
+    FdTable& operator=(const FdTable&) = delete;
+
+    /// @brief Returns the descriptor limit of the process, the initial capacity of a table.
+    static size_t defaultCapacity() noexcept
+    {
+        rlimit limit;
+        if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+        {
+            return static_cast<size_t>(limit.rlim_cur);
+        }
+        return 1024;
+    }
+
+    /// @brief Returns the entry of fd, nullptr if its chunk was never allocated.
+    T* find(int fd) noexcept
+    {
+        auto index = static_cast<size_t>(fd);
+        if (fd < 0 || index / kChunkEntries >= directory_.size())
+        {
+            return nullptr;
+        }
+
+        T* chunk = directory_[index / kChunkEntries].get();
+        return chunk ? chunk + index % kChunkEntries : nullptr;
+    }
+
+    const T* find(int fd) const noexcept
+    {
+        return const_cast<FdTable*>(this)->find(fd);
+    }
+
+    /// @brief Returns the entry of fd, allocating its chunk if needed.
+    /// @return nullptr if fd is negative or memory is exhausted.
+    T* acquire(int fd) noexcept
+    {
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+
+        auto index = static_cast<size_t>(fd);
+        size_t chunkIndex = index / kChunkEntries;
+        if (chunkIndex >= directory_.size() && !grow(chunkIndex + 1))
+        {
+            return nullptr;
+        }
+
+        auto& chunk = directory_[chunkIndex];
+        if (!chunk)
+        {
+            chunk.reset(new (std::nothrow) T[kChunkEntries]());
+            if (!chunk)
+            {
+                return nullptr;
+            }
+            ++allocatedChunks_;
+        }
+        return chunk.get() + index % kChunkEntries;
+    }
+
+    /// @brief Calls fn(fd, entry) for every entry of every allocated chunk.
+    template <typename Fn>
+    void forEach(Fn&& fn)
+    {
+        for (size_t chunkIndex = 0; chunkIndex < directory_.size(); ++chunkIndex)
+        {
+            T* chunk = directory_[chunkIndex].get();
+            if (!chunk)
+            {
+                continue;
+            }
+
+            for (size_t i = 0; i < kChunkEntries; ++i)
+            {
+                fn(static_cast<int>(chunkIndex * kChunkEntries + i), chunk[i]);
+            }
+        }
+    }
+
+    /// @brief Releases every chunk, the directory keeps its size.
+    void clear() noexcept
+    {
+        for (auto& chunk : directory_)
+        {
+            chunk.reset();
+        }
+        allocatedChunks_ = 0;
+    }
+
+    /// @brief Number of descriptors addressable without growing the directory.
+    size_t capacity() const noexcept
+    {
+        return directory_.size() * kChunkEntries;
+    }
+
+    /// @brief Heap bytes held by the directory and the allocated chunks.
+    size_t memoryUsage() const noexcept
+    {
+        return directory_.capacity() * sizeof(directory_[0]) + allocatedChunks_ * kChunkEntries * sizeof(T);
+    }
+
+private:
+    bool grow(size_t minChunks) noexcept
+    {
+        size_t size = directory_.size() > 0 ? directory_.size() : 1;
+        while (size < minChunks)
+        {
+            size *= 2;
+        }
+
+        try
+        {
+            directory_.resize(size);
+        }
+        catch (const std::bad_alloc&)
+        {
+            return false;
+        }
+        return true;
+    }
+
+private:
+    std::vector<std::unique_ptr<T[]>> directory_;
+    size_t allocatedChunks_{0};
+};
+
+} // namespace casket
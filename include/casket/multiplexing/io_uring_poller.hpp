@@ -0,0 +1,1082 @@
+#pragma once
+
+#include <linux/io_uring.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <vector>
+
+#include <casket/multiplexing/connection_context.hpp>
+#include <casket/multiplexing/fd_table.hpp>
+
+namespace casket
+{
+
+namespace detail
+{
+
+/// @brief Minimal io_uring instance driven through raw syscalls, no liburing dependency.
+class IoUring final
+{
+public:
+    IoUring() = default;
+
+    ~IoUring() noexcept
+    {
+        close();
+    }
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    /// @brief Creates the ring, fails with function_not_supported on kernels without IORING_FEAT_EXT_ARG (5.11).
+    bool open(unsigned entries, std::error_code& ec) noexcept
+    {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+
+        fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0)
+        {
+            ec = std::error_code(errno, std::system_category());
+            return false;
+        }
+
+        if (!(params.features & IORING_FEAT_EXT_ARG))
+        {
+            close();
+            ec = std::make_error_code(std::errc::function_not_supported);
+            return false;
+        }
+
+        sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMmap)
+        {
+            sqRingSize_ = cqRingSize_ = sqRingSize_ > cqRingSize_ ? sqRingSize_ : cqRingSize_;
+        }
+
+        sqRing_ = map(sqRingSize_, IORING_OFF_SQ_RING);
+        cqRing_ = singleMmap ? sqRing_ : map(cqRingSize_, IORING_OFF_CQ_RING);
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqesSize_, IORING_OFF_SQES));
+        if (!sqRing_ || !cqRing_ || !sqes_)
+        {
+            ec = std::error_code(errno, std::system_category());
+            close();
+            return false;
+        }
+
+        auto* sq = static_cast<char*>(sqRing_);
+        sqHead_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqFlags_ = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+        sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqEntries_ = params.sq_entries;
+
+        // Identity mapping, SQE i is always published through array slot i.
+        auto* array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        for (unsigned i = 0; i < sqEntries_; ++i)
+        {
+            array[i] = i;
+        }
+
+        auto* cq = static_cast<char*>(cqRing_);
+        cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        sqeTail_ = *sqTail_;
+        return true;
+    }
+
+    void close() noexcept
+    {
+        if (sqes_)
+        {
+            ::munmap(sqes_, sqesSize_);
+        }
+        if (cqRing_ && cqRing_ != sqRing_)
+        {
+            ::munmap(cqRing_, cqRingSize_);
+        }
+        if (sqRing_)
+        {
+            ::munmap(sqRing_, sqRingSize_);
+        }
+        sqes_ = nullptr;
+        cqRing_ = sqRing_ = nullptr;
+
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    bool isOpen() const noexcept
+    {
+        return fd_ >= 0;
+    }
+
+    /// @brief Returns a zeroed SQE, or nullptr if the submission queue is full.
+    io_uring_sqe* getSqe() noexcept
+    {
+        unsigned head = __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+        if (sqeTail_ - head >= sqEntries_)
+        {
+            return nullptr;
+        }
+
+        io_uring_sqe* sqe = &sqes_[sqeTail_ & sqMask_];
+        ++sqeTail_;
+        std::memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    /// @brief Number of SQEs handed out so far, used to detect adjacent SQEs.
+    unsigned queuedTail() const noexcept
+    {
+        return sqeTail_;
+    }
+
+    /// @brief Returns true if SQEs were handed out since the last submit().
+    bool hasQueued() const noexcept
+    {
+        return sqeTail_ != *sqTail_;
+    }
+
+    /// @brief Submits queued SQEs and optionally waits for completions.
+    /// @param[in] timeoutMs wait limit when waitNr > 0, -1 waits indefinitely.
+    /// @return number of submitted SQEs, 0 on timeout, -1 on error.
+    int submit(unsigned waitNr, int timeoutMs, std::error_code& ec) noexcept
+    {
+        unsigned toSubmit = sqeTail_ - *sqTail_;
+        __atomic_store_n(sqTail_, sqeTail_, __ATOMIC_RELEASE);
+
+        unsigned flags = 0;
+        io_uring_getevents_arg arg;
+        __kernel_timespec ts;
+        std::memset(&arg, 0, sizeof(arg));
+
+        if (waitNr > 0 || (__atomic_load_n(sqFlags_, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW))
+        {
+            flags |= IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+            arg.sigmask_sz = _NSIG / 8;
+            if (timeoutMs >= 0)
+            {
+                ts.tv_sec = timeoutMs / 1000;
+                ts.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+                arg.ts = reinterpret_cast<uint64_t>(&ts);
+            }
+        }
+        else if (toSubmit == 0)
+        {
+            return 0;
+        }
+
+        int ret = static_cast<int>(
+            ::syscall(__NR_io_uring_enter, fd_, toSubmit, waitNr, flags, flags ? &arg : nullptr, sizeof(arg)));
+        if (ret < 0)
+        {
+            if (errno == ETIME)
+            {
+                return 0;
+            }
+            ec = std::error_code(errno, std::system_category());
+            return -1;
+        }
+        return ret;
+    }
+
+    /// @brief Returns the oldest unconsumed CQE or nullptr, call advance() once it is copied.
+    const io_uring_cqe* peek() const noexcept
+    {
+        unsigned head = *cqHead_;
+        if (head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE))
+        {
+            return nullptr;
+        }
+        return &cqes_[head & cqMask_];
+    }
+
+    void advance() noexcept
+    {
+        __atomic_store_n(cqHead_, *cqHead_ + 1, __ATOMIC_RELEASE);
+    }
+
+    int registerOp(unsigned opcode, const void* arg, unsigned count, std::error_code& ec) noexcept
+    {
+        int ret = static_cast<int>(::syscall(__NR_io_uring_register, fd_, opcode, arg, count));
+        if (ret < 0)
+        {
+            ec = std::error_code(errno, std::system_category());
+        }
+        return ret;
+    }
+
+private:
+    void* map(size_t size, off_t offset) noexcept
+    {
+        void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+private:
+    int fd_{-1};
+    void* sqRing_{nullptr};
+    void* cqRing_{nullptr};
+    io_uring_sqe* sqes_{nullptr};
+    size_t sqRingSize_{0};
+    size_t cqRingSize_{0};
+    size_t sqesSize_{0};
+    unsigned* sqHead_{nullptr};
+    unsigned* sqTail_{nullptr};
+    unsigned* sqFlags_{nullptr};
+    unsigned sqMask_{0};
+    unsigned sqEntries_{0};
+    unsigned sqeTail_{0};
+    unsigned* cqHead_{nullptr};
+    unsigned* cqTail_{nullptr};
+    unsigned cqMask_{0};
+    io_uring_cqe* cqes_{nullptr};
+};
+
+} // namespace detail
+
+/// @brief Poller backed by io_uring poll requests, with an optional completion-based I/O path.
+/// @details Registrations are queued as SQEs and submitted together by the next wait(), so add(), modify()
+///          and remove() cost no syscall. Edge-triggered interest maps to a multishot poll, level-triggered
+///          interest to a one-shot poll that is re-armed by the following wait(). Errors of queued requests,
+///          e.g. a bad descriptor, are reported by wait() as an Error event instead of by add().
+///
+///          The completion path delivers data without readiness round trips: recvMultishot() receives into
+///          buffers of a provided buffer ring, send() queues sends that are linked when adjacent for the same
+///          descriptor. Their results are reported as events with EventType::Completion set.
+/// @note Requires Linux 6.0 for the completion path, 5.11 for the poller itself. Use isSupported() and
+///       isRecvMultishotSupported() to probe.
+template <typename ContextManager = DirectContext>
+class IoUringPollerTemplate : public PollerBase<IoUringPollerTemplate<ContextManager>>
+{
+private:
+    using Context = typename ContextManager::Context;
+    using ContextPtr = typename ContextManager::ContextPtr;
+
+    static constexpr unsigned RING_ENTRIES = 256;
+    static constexpr uint16_t BUFFER_GROUP = 0;
+
+    enum Op : uint64_t
+    {
+        OpInternal = 0,
+        OpPoll = 1,
+        OpRecv = 2,
+        OpSend = 3
+    };
+
+    struct Slot
+    {
+        ContextPtr ctx{nullptr};
+        uint32_t generation{0}; ///< Tags recv and send requests of the current registration.
+        uint32_t pollSeq{0};    ///< Tags the current poll request.
+        bool pollArmed{false};
+        bool recvArmed{false};
+        bool recvWanted{false};
+    };
+
+public:
+    IoUringPollerTemplate()
+    {
+        std::error_code ec;
+        if (!ring_.open(RING_ENTRIES, ec))
+        {
+            throw std::system_error(ec, "Failed to create io_uring");
+        }
+    }
+
+    ~IoUringPollerTemplate()
+    {
+        destroyImpl();
+    }
+
+    IoUringPollerTemplate(const IoUringPollerTemplate&) = delete;
+    IoUringPollerTemplate& operator=(const IoUringPollerTemplate&) = delete;
+
+    IoUringPollerTemplate(IoUringPollerTemplate&&) = delete;
+    IoUringPollerTemplate& operator=(IoUringPollerTemplate&&) = delete;
+
+    /// @brief Returns true if the running kernel provides everything the poller needs.
+    static bool isSupported() noexcept
+    {
+        detail::IoUring ring;
+        std::error_code ec;
+        return ring.open(4, ec);
+    }
+
+    /// @brief Returns true if the running kernel supports multishot recv (Linux 6.0), as used by recvMultishot().
+    static bool isRecvMultishotSupported() noexcept
+    {
+        static const bool supported = probeRecvMultishot();
+        return supported;
+    }
+
+    size_t getUsedContextsCount() const
+    {
+        return contextManager_.usedCount();
+    }
+
+    void addImpl(int fd, EventType events, std::error_code& ec) noexcept
+    {
+        if (fd < 0)
+        {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return;
+        }
+
+        Slot* entry = slots_.acquire(fd);
+        if (!entry)
+        {
+            ec = std::make_error_code(std::errc::not_enough_memory);
+            return;
+        }
+
+        Slot& slot = *entry;
+        if (slot.ctx != nullptr)
+        {
+            ec = std::make_error_code(std::errc::file_exists);
+            return;
+        }
+
+        ContextPtr ctx = contextManager_.create();
+        if (!ctx)
+        {
+            ec = std::make_error_code(std::errc::not_enough_memory);
+            return;
+        }
+
+        ctx->fd = fd;
+        ctx->registeredEvents = events;
+        ctx->generation = nextSeq();
+
+        slot = Slot{};
+        slot.ctx = ctx;
+        slot.generation = ctx->generation;
+
+        if (!armPoll(fd, slot, ec))
+        {
+            contextManager_.destroy(ctx);
+            slot = Slot{};
+            return;
+        }
+
+        ec.clear();
+    }
+
+    void addPtrImpl(void* ptr, int fd, EventType events, std::error_code& ec) noexcept
+    {
+        addImpl(fd, events, ec);
+        if (!ec)
+        {
+            slots_.find(fd)->ctx->userData = ptr;
+        }
+    }
+
+    void modifyImpl(int fd, EventType events, std::error_code& ec) noexcept
+    {
+        Slot* slot = find(fd, ec);
+        if (!slot)
+        {
+            return;
+        }
+
+        if (slot->ctx->registeredEvents == events && (events & EventType::OneShot) == EventType::None)
+        {
+            return;
+        }
+
+        slot->ctx->registeredEvents = events;
+        disarmPoll(fd, *slot, ec);
+        if (!ec)
+        {
+            armPoll(fd, *slot, ec);
+        }
+    }
+
+    void modifyPtrImpl(void* ptr, int fd, EventType events, std::error_code& ec) noexcept
+    {
+        modifyImpl(fd, events, ec);
+        if (!ec)
+        {
+            slots_.find(fd)->ctx->userData = ptr;
+        }
+    }
+
+    void removeImpl(int fd, std::error_code& ec) noexcept
+    {
+        Slot* slot = find(fd, ec);
+        if (!slot)
+        {
+            return;
+        }
+
+        // Late completions of the cancelled requests no longer match the slot and are dropped.
+        disarmPoll(fd, *slot, ec);
+        if (slot->recvArmed)
+        {
+            cancel(encode(OpRecv, slot->generation, fd), ec);
+        }
+
+        contextManager_.destroy(slot->ctx);
+        *slot = Slot{};
+    }
+
+    int waitImpl(PollEvent* events, int maxCount, int timeoutMs, std::error_code& ec) noexcept
+    {
+        if (maxCount <= 0)
+        {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return -1;
+        }
+
+        recycleBuffers();
+        rearm(ec);
+        if (ec)
+        {
+            return -1;
+        }
+
+        // Queued registrations, re-arms and sends go out now, even while completions keep arriving.
+        if (ring_.hasQueued())
+        {
+            lastSendFd_ = -1;
+            if (ring_.submit(0, 0, ec) < 0)
+            {
+                return -1;
+            }
+        }
+
+        int count = harvest(events, maxCount);
+        if (count == 0)
+        {
+            if (ring_.submit(timeoutMs != 0 ? 1 : 0, timeoutMs, ec) < 0)
+            {
+                return -1;
+            }
+            count = harvest(events, maxCount);
+        }
+
+        ec.clear();
+        return count;
+    }
+
+    bool isValidImpl() const noexcept
+    {
+        return ring_.isOpen();
+    }
+
+    void destroyImpl() noexcept
+    {
+        slots_.forEach(
+            [this](int, Slot& slot)
+            {
+                if (slot.ctx)
+                {
+                    contextManager_.destroy(slot.ctx);
+                }
+            });
+        slots_.clear();
+        contextManager_.clear();
+
+        ring_.close();
+        releaseBufferRing();
+        rearmPoll_.clear();
+        rearmRecv_.clear();
+        recycle_.clear();
+    }
+
+    /// @brief Registers a ring of provided buffers used by recvMultishot().
+    /// @details Fails with function_not_supported if the kernel lacks multishot recv, the buffers would be useless.
+    /// @param[in] count number of buffers, a power of two up to 32768.
+    /// @param[in] size size of each buffer, one completion never carries more.
+    bool setupBufferRing(uint16_t count, uint32_t size, std::error_code& ec) noexcept
+    {
+        if (count == 0 || (count & (count - 1)) != 0 || count > 32768 || size == 0 || bufRing_)
+        {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+
+        if (!isRecvMultishotSupported())
+        {
+            ec = std::make_error_code(std::errc::function_not_supported);
+            return false;
+        }
+
+        bufRingBytes_ = count * sizeof(io_uring_buf);
+        bufBytes_ = static_cast<size_t>(count) * size;
+        void* ring = ::mmap(nullptr, bufRingBytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        void* data = ::mmap(nullptr, bufBytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ring == MAP_FAILED || data == MAP_FAILED)
+        {
+            ec = std::error_code(errno, std::system_category());
+            if (ring != MAP_FAILED)
+                ::munmap(ring, bufRingBytes_);
+            if (data != MAP_FAILED)
+                ::munmap(data, bufBytes_);
+            return false;
+        }
+
+        io_uring_buf_reg reg;
+        std::memset(&reg, 0, sizeof(reg));
+        reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+        reg.ring_entries = count;
+        reg.bgid = BUFFER_GROUP;
+        if (ring_.registerOp(IORING_REGISTER_PBUF_RING, &reg, 1, ec) < 0)
+        {
+            ::munmap(ring, bufRingBytes_);
+            ::munmap(data, bufBytes_);
+            return false;
+        }
+
+        bufRing_ = static_cast<io_uring_buf_ring*>(ring);
+        bufData_ = static_cast<uint8_t*>(data);
+        bufCount_ = count;
+        bufSize_ = size;
+        bufTail_ = 0;
+        for (uint16_t bid = 0; bid < count; ++bid)
+        {
+            pushBuffer(bid);
+        }
+        __atomic_store_n(&bufRing_->tail, bufTail_, __ATOMIC_RELEASE);
+
+        ec.clear();
+        return true;
+    }
+
+    bool hasBufferRing() const noexcept
+    {
+        return bufRing_ != nullptr;
+    }
+
+    /// @brief Starts receiving on a registered descriptor into the provided buffer ring.
+    /// @details Each chunk is reported as a Readable|Completion event whose data stays valid until the next
+    ///          wait(). End of stream is reported as HangUp|Completion, errors as Error|Completion. The
+    ///          receive is re-armed transparently when it stops because the buffer ring ran dry.
+    void recvMultishot(int fd, std::error_code& ec) noexcept
+    {
+        Slot* slot = find(fd, ec);
+        if (!slot)
+        {
+            return;
+        }
+
+        if (!bufRing_)
+        {
+            ec = std::make_error_code(std::errc::no_buffer_space);
+            return;
+        }
+
+        slot->recvWanted = true;
+        if (!slot->recvArmed)
+        {
+            armRecv(fd, *slot, ec);
+        }
+    }
+
+    /// @brief Queues a send on a registered descriptor, data must stay valid until its completion.
+    /// @details Sends queued back to back for the same descriptor are linked, so they are performed in
+    ///          order and a failure cancels the rest. The result is reported as a Writable|Completion event.
+    void send(int fd, const void* data, size_t size, std::error_code& ec) noexcept
+    {
+        Slot* slot = find(fd, ec);
+        if (!slot)
+        {
+            return;
+        }
+
+        io_uring_sqe* sqe = acquireSqe(ec);
+        if (!sqe)
+        {
+            return;
+        }
+
+        if (lastSendFd_ == fd && lastSendTail_ + 1 == ring_.queuedTail())
+        {
+            lastSendSqe_->flags |= IOSQE_IO_LINK;
+        }
+
+        sqe->opcode = IORING_OP_SEND;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<uint64_t>(data);
+        sqe->len = static_cast<uint32_t>(size);
+        sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+        sqe->user_data = encode(OpSend, slot->generation, fd);
+
+        lastSendSqe_ = sqe;
+        lastSendFd_ = fd;
+        lastSendTail_ = ring_.queuedTail();
+    }
+
+    /// @brief Submits queued requests without waiting.
+    void flush(std::error_code& ec) noexcept
+    {
+        lastSendFd_ = -1;
+        if (ring_.submit(0, 0, ec) >= 0)
+        {
+            ec.clear();
+        }
+    }
+
+private:
+    // Buffer rings (5.19) predate multishot recv (6.0), so the only reliable probe is a real receive:
+    // unsupported kernels fail it with EINVAL, supported ones deliver the pending byte with IORING_CQE_F_MORE.
+    static bool probeRecvMultishot() noexcept
+    {
+        detail::IoUring ring;
+        std::error_code ec;
+        if (!ring.open(4, ec))
+        {
+            return false;
+        }
+
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) < 0)
+        {
+            return false;
+        }
+
+        // A single page holds the one-entry buffer ring followed by its buffer.
+        const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        void* page = ::mmap(nullptr, pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        bool supported = false;
+        if (page != MAP_FAILED)
+        {
+            auto* bufs = static_cast<io_uring_buf*>(page);
+            bufs[0].addr = reinterpret_cast<uint64_t>(static_cast<uint8_t*>(page) + 64);
+            bufs[0].len = 64;
+            bufs[0].bid = 0;
+            __atomic_store_n(&static_cast<io_uring_buf_ring*>(page)->tail, 1, __ATOMIC_RELEASE);
+
+            io_uring_buf_reg reg;
+            std::memset(&reg, 0, sizeof(reg));
+            reg.ring_addr = reinterpret_cast<uint64_t>(page);
+            reg.ring_entries = 1;
+            reg.bgid = BUFFER_GROUP;
+
+            const char byte = 0;
+            io_uring_sqe* sqe = ring.getSqe();
+            if (ring.registerOp(IORING_REGISTER_PBUF_RING, &reg, 1, ec) >= 0 && sqe &&
+                ::send(fds[1], &byte, 1, MSG_NOSIGNAL) == 1)
+            {
+                sqe->opcode = IORING_OP_RECV;
+                sqe->fd = fds[0];
+                sqe->ioprio = IORING_RECV_MULTISHOT;
+                sqe->flags = IOSQE_BUFFER_SELECT;
+                sqe->buf_group = BUFFER_GROUP;
+
+                if (ring.submit(1, 1000, ec) > 0)
+                {
+                    const io_uring_cqe* cqe = ring.peek();
+                    supported = cqe && cqe->res > 0 && (cqe->flags & IORING_CQE_F_MORE);
+                }
+            }
+        }
+
+        // The ring goes first, so the pending receive is cancelled before its buffer is unmapped.
+        ring.close();
+        ::close(fds[0]);
+        ::close(fds[1]);
+        if (page != MAP_FAILED)
+        {
+            ::munmap(page, pageSize);
+        }
+        return supported;
+    }
+
+    static uint64_t encode(uint64_t op, uint32_t seq, int fd) noexcept
+    {
+        return (op << 60) | (static_cast<uint64_t>(seq & 0x0FFFFFFF) << 32) | static_cast<uint32_t>(fd);
+    }
+
+    static bool wantsPoll(EventType events) noexcept
+    {
+        return (events & (EventType::Readable | EventType::Writable | EventType::HangUp)) != EventType::None;
+    }
+
+    static uint32_t convertEventsToPoll(EventType events) noexcept
+    {
+        uint32_t result = 0;
+        if ((events & EventType::Readable) != EventType::None)
+            result |= EPOLLIN;
+        if ((events & EventType::Writable) != EventType::None)
+            result |= EPOLLOUT;
+        if ((events & EventType::Error) != EventType::None)
+            result |= EPOLLERR;
+        if ((events & EventType::HangUp) != EventType::None)
+            result |= EPOLLHUP | EPOLLRDHUP;
+        return result;
+    }
+
+    static EventType convertPollToEvents(uint32_t revents) noexcept
+    {
+        EventType result = EventType::None;
+        if (revents & EPOLLIN)
+            result |= EventType::Readable;
+        if (revents & EPOLLOUT)
+            result |= EventType::Writable;
+        if (revents & EPOLLERR)
+            result |= EventType::Error;
+        if (revents & (EPOLLHUP | EPOLLRDHUP))
+            result |= EventType::HangUp;
+        return result;
+    }
+
+    uint32_t nextSeq() noexcept
+    {
+        seq_ = (seq_ + 1) & 0x0FFFFFFF;
+        if (seq_ == 0)
+        {
+            seq_ = 1;
+        }
+        return seq_;
+    }
+
+    Slot* find(int fd, std::error_code& ec) noexcept
+    {
+        if (fd < 0)
+        {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return nullptr;
+        }
+
+        Slot* slot = slots_.find(fd);
+        if (!slot || !slot->ctx)
+        {
+            ec = std::make_error_code(std::errc::no_such_file_or_directory);
+            return nullptr;
+        }
+
+        ec.clear();
+        return slot;
+    }
+
+    io_uring_sqe* acquireSqe(std::error_code& ec) noexcept
+    {
+        io_uring_sqe* sqe = ring_.getSqe();
+        if (!sqe)
+        {
+            lastSendFd_ = -1;
+            if (ring_.submit(0, 0, ec) < 0)
+            {
+                return nullptr;
+            }
+            sqe = ring_.getSqe();
+            if (!sqe)
+            {
+                ec = std::make_error_code(std::errc::device_or_resource_busy);
+            }
+        }
+        return sqe;
+    }
+
+    bool armPoll(int fd, Slot& slot, std::error_code& ec) noexcept
+    {
+        EventType events = slot.ctx->registeredEvents;
+        if (!wantsPoll(events))
+        {
+            return true;
+        }
+
+        io_uring_sqe* sqe = acquireSqe(ec);
+        if (!sqe)
+        {
+            return false;
+        }
+
+        slot.pollSeq = nextSeq();
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = fd;
+        sqe->poll32_events = convertEventsToPoll(events);
+        if ((events & (EventType::EdgeTriggered | EventType::OneShot)) == EventType::EdgeTriggered)
+        {
+            sqe->len = IORING_POLL_ADD_MULTI;
+        }
+        sqe->user_data = encode(OpPoll, slot.pollSeq, fd);
+        slot.pollArmed = true;
+        return true;
+    }
+
+    void disarmPoll(int fd, Slot& slot, std::error_code& ec) noexcept
+    {
+        if (!slot.pollArmed)
+        {
+            return;
+        }
+
+        io_uring_sqe* sqe = acquireSqe(ec);
+        if (!sqe)
+        {
+            return;
+        }
+
+        sqe->opcode = IORING_OP_POLL_REMOVE;
+        sqe->addr = encode(OpPoll, slot.pollSeq, fd);
+        sqe->user_data = encode(OpInternal, 0, fd);
+        slot.pollArmed = false;
+    }
+
+    void armRecv(int fd, Slot& slot, std::error_code& ec) noexcept
+    {
+        io_uring_sqe* sqe = acquireSqe(ec);
+        if (!sqe)
+        {
+            return;
+        }
+
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = fd;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = BUFFER_GROUP;
+        sqe->user_data = encode(OpRecv, slot.generation, fd);
+        slot.recvArmed = true;
+    }
+
+    void cancel(uint64_t target, std::error_code& ec) noexcept
+    {
+        io_uring_sqe* sqe = acquireSqe(ec);
+        if (sqe)
+        {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->addr = target;
+            sqe->user_data = encode(OpInternal, 0, 0);
+        }
+    }
+
+    // One-shot polls and stopped receives are re-armed once the caller has handled their last event.
+    void rearm(std::error_code& ec) noexcept
+    {
+        for (int fd : rearmPoll_)
+        {
+            Slot* slot = slots_.find(fd);
+            if (slot && slot->ctx && !slot->pollArmed && !armPoll(fd, *slot, ec))
+            {
+                return;
+            }
+        }
+        rearmPoll_.clear();
+
+        for (int fd : rearmRecv_)
+        {
+            Slot* slot = slots_.find(fd);
+            if (slot && slot->ctx && slot->recvWanted && !slot->recvArmed)
+            {
+                armRecv(fd, *slot, ec);
+                if (ec)
+                {
+                    return;
+                }
+            }
+        }
+        rearmRecv_.clear();
+    }
+
+    int harvest(PollEvent* events, int maxCount) noexcept
+    {
+        int count = 0;
+        while (count < maxCount)
+        {
+            const io_uring_cqe* cqe = ring_.peek();
+            if (!cqe)
+            {
+                break;
+            }
+
+            uint64_t userData = cqe->user_data;
+            int32_t res = cqe->res;
+            uint32_t flags = cqe->flags;
+            ring_.advance();
+
+            if (translate(userData, res, flags, events[count]))
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    bool translate(uint64_t userData, int32_t res, uint32_t flags, PollEvent& event) noexcept
+    {
+        uint64_t op = userData >> 60;
+        auto seq = static_cast<uint32_t>((userData >> 32) & 0x0FFFFFFF);
+        auto fd = static_cast<int>(static_cast<uint32_t>(userData));
+        bool more = flags & IORING_CQE_F_MORE;
+
+        if (flags & IORING_CQE_F_BUFFER)
+        {
+            recycle_.push_back(static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT));
+        }
+
+        Slot* entry = op == OpInternal ? nullptr : slots_.find(fd);
+        if (!entry || !entry->ctx)
+        {
+            return false;
+        }
+
+        Slot& slot = *entry;
+
+        EventType revents = EventType::None;
+        event.data = nullptr;
+        event.result = 0;
+
+        switch (op)
+        {
+        case OpPoll:
+            if (seq != slot.pollSeq || res == -ECANCELED)
+            {
+                return false;
+            }
+            if (!more)
+            {
+                slot.pollArmed = false;
+                if ((slot.ctx->registeredEvents & EventType::OneShot) == EventType::None)
+                {
+                    rearmPoll_.push_back(fd);
+                }
+            }
+            revents = res < 0 ? EventType::Error
+                              : convertPollToEvents(static_cast<uint32_t>(res)) &
+                                    (slot.ctx->registeredEvents | EventType::Error | EventType::HangUp);
+            break;
+
+        case OpRecv:
+            if (seq != slot.generation)
+            {
+                return false;
+            }
+            if (!more)
+            {
+                slot.recvArmed = false;
+            }
+            if (res == -ENOBUFS)
+            {
+                rearmRecv_.push_back(fd);
+                return false;
+            }
+
+            if (res > 0)
+            {
+                revents = EventType::Readable | EventType::Completion;
+                if (flags & IORING_CQE_F_BUFFER)
+                {
+                    event.data = bufData_ + static_cast<size_t>(flags >> IORING_CQE_BUFFER_SHIFT) * bufSize_;
+                }
+                if (!more)
+                {
+                    rearmRecv_.push_back(fd);
+                }
+            }
+            else
+            {
+                slot.recvWanted = false;
+                revents = (res == 0 ? EventType::HangUp : EventType::Error) | EventType::Completion;
+            }
+            event.result = res;
+            break;
+
+        case OpSend:
+            if (seq != slot.generation)
+            {
+                return false;
+            }
+            revents = (res < 0 ? EventType::Error : EventType::Writable) | EventType::Completion;
+            event.result = res;
+            break;
+
+        default:
+            return false;
+        }
+
+        if (revents == EventType::None)
+        {
+            return false;
+        }
+
+        event.fd = fd;
+        event.userData = slot.ctx->userData;
+        event.events = slot.ctx->registeredEvents;
+        event.revents = revents;
+        return true;
+    }
+
+    void pushBuffer(uint16_t bid) noexcept
+    {
+        // Indexed by hand, the flexible array member of io_uring_buf_ring is misplaced when compiled as C++.
+        io_uring_buf& buf = reinterpret_cast<io_uring_buf*>(bufRing_)[bufTail_ & (bufCount_ - 1)];
+        buf.addr = reinterpret_cast<uint64_t>(bufData_ + static_cast<size_t>(bid) * bufSize_);
+        buf.len = bufSize_;
+        buf.bid = bid;
+        ++bufTail_;
+    }
+
+    // Buffers handed out by the previous wait() go back to the kernel.
+    void recycleBuffers() noexcept
+    {
+        if (recycle_.empty() || !bufRing_)
+        {
+            recycle_.clear();
+            return;
+        }
+
+        for (uint16_t bid : recycle_)
+        {
+            pushBuffer(bid);
+        }
+        recycle_.clear();
+        __atomic_store_n(&bufRing_->tail, bufTail_, __ATOMIC_RELEASE);
+    }
+
+    void releaseBufferRing() noexcept
+    {
+        if (bufRing_)
+        {
+            ::munmap(bufRing_, bufRingBytes_);
+            ::munmap(bufData_, bufBytes_);
+            bufRing_ = nullptr;
+            bufData_ = nullptr;
+        }
+    }
+
+private:
+    detail::IoUring ring_;
+    FdTable<Slot> slots_;
+    ContextManager contextManager_;
+    uint32_t seq_{0};
+
+    std::vector<int> rearmPoll_;
+    std::vector<int> rearmRecv_;
+    std::vector<uint16_t> recycle_;
+
+    io_uring_sqe* lastSendSqe_{nullptr};
+    int lastSendFd_{-1};
+    unsigned lastSendTail_{0};
+
+    io_uring_buf_ring* bufRing_{nullptr};
+    uint8_t* bufData_{nullptr};
+    size_t bufRingBytes_{0};
+    size_t bufBytes_{0};
+    uint16_t bufCount_{0};
+    uint16_t bufTail_{0};
+    uint32_t bufSize_{0};
+};
+
+using IoUringPoller = IoUringPollerTemplate<DirectContext>;
+
+} // namespace casket
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <new>
 #include <unordered_map>
 #include <vector>
 
@@ -27,10 +32,20 @@ public:
     }
 };
 
-template <typename T, size_t PoolSize = 10000>
+/// @brief Pool of T allocated in chunks of ChunkSize slots.
+/// @details Chunks are added when the free list runs dry and are kept until the policy is destroyed,
+///          so objects never move and the pool is only bounded by memory. Each chunk carries an
+///          occupancy bitmap, which makes clear(), forEach() and leak checks linear in the pool size.
+template <typename T, size_t ChunkSize = 1024>
 class PoolMemoryPolicy
 {
 private:
+    static_assert(ChunkSize > 0, "ChunkSize must be positive");
+
+    static constexpr size_t kNone = static_cast<size_t>(-1);
+    static constexpr size_t kWordBits = 64;
+    static constexpr size_t kWords = (ChunkSize + kWordBits - 1) / kWordBits;
+
     union Slot
     {
         T object;
@@ -45,35 +60,73 @@ private:
         }
     };
 
-    std::array<Slot, PoolSize> pool_;
+    struct Chunk
+    {
+        std::array<Slot, ChunkSize> slots;
+        std::array<uint64_t, kWords> used{};
+    };
+
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    std::vector<std::pair<const Slot*, size_t>> chunksByAddress_;
     size_t freeHead_;
     size_t usedCount_;
 
 public:
     PoolMemoryPolicy()
-        : freeHead_(0)
+        : freeHead_(kNone)
         , usedCount_(0)
     {
-        for (size_t i = 0; i < PoolSize - 1; ++i)
+    }
+
+    PoolMemoryPolicy(PoolMemoryPolicy&& other) noexcept
+        : chunks_(std::move(other.chunks_))
+        , chunksByAddress_(std::move(other.chunksByAddress_))
+        , freeHead_(other.freeHead_)
+        , usedCount_(other.usedCount_)
+    {
+        other.chunks_.clear();
+        other.chunksByAddress_.clear();
+        other.freeHead_ = kNone;
+        other.usedCount_ = 0;
+    }
+
+    PoolMemoryPolicy& operator=(PoolMemoryPolicy&& other) noexcept
+    {
+        if (this != &other)
         {
-            pool_[i].nextFree = i + 1;
+            clear();
+            chunks_ = std::move(other.chunks_);
+            chunksByAddress_ = std::move(other.chunksByAddress_);
+            freeHead_ = other.freeHead_;
+            usedCount_ = other.usedCount_;
+            other.chunks_.clear();
+            other.chunksByAddress_.clear();
+            other.freeHead_ = kNone;
+            other.usedCount_ = 0;
         }
-        pool_[PoolSize - 1].nextFree = PoolSize;
+        return *this;
+    }
+
+    ~PoolMemoryPolicy()
+    {
+        clear();
     }
 
     T* create()
     {
-        if (freeHead_ >= PoolSize)
+        if (freeHead_ == kNone && !addChunk())
         {
             return nullptr;
         }
 
         size_t index = freeHead_;
-        freeHead_ = pool_[freeHead_].nextFree;
-        usedCount_++;
+        Slot& slot = slotAt(index);
+        freeHead_ = slot.nextFree;
 
-        T* ptr = &pool_[index].object;
+        T* ptr = &slot.object;
         new (ptr) T();
+        markUsed(index, true);
+        usedCount_++;
         return ptr;
     }
 
@@ -82,29 +135,55 @@ public:
         if (!ptr)
             return;
 
+        size_t index = indexOf(reinterpret_cast<const Slot*>(ptr));
+        if (index == kNone || !isUsed(index))
+            return;
+
         ptr->~T();
-        size_t index = reinterpret_cast<Slot*>(ptr) - pool_.data();
-        pool_[index].nextFree = freeHead_;
+        markUsed(index, false);
+        slotAt(index).nextFree = freeHead_;
         freeHead_ = index;
         usedCount_--;
     }
 
+    /// @brief Destroys every live object, the chunks are kept for reuse.
     void clear()
     {
-        for (size_t i = 0; i < PoolSize; ++i)
+        forEach([](T& object) { object.~T(); });
+
+        freeHead_ = kNone;
+        usedCount_ = 0;
+        for (size_t c = chunks_.size(); c-- > 0;)
         {
-            if (isUsed(i))
-            {
-                pool_[i].object.~T();
-            }
+            chunks_[c]->used.fill(0);
+            linkChunk(c);
         }
-        freeHead_ = 0;
-        usedCount_ = 0;
-        for (size_t i = 0; i < PoolSize - 1; ++i)
+    }
+
+    /// @brief Calls fn(T&) for every live object, in address order within a chunk.
+    template <typename Fn>
+    void forEach(Fn&& fn)
+    {
+        for (auto& chunk : chunks_)
         {
-            pool_[i].nextFree = i + 1;
+            for (size_t w = 0; w < kWords; ++w)
+            {
+                uint64_t bits = chunk->used[w];
+                while (bits)
+                {
+                    size_t bit = static_cast<size_t>(__builtin_ctzll(bits));
+                    bits &= bits - 1;
+                    fn(chunk->slots[w * kWordBits + bit].object);
+                }
+            }
         }
-        pool_[PoolSize - 1].nextFree = PoolSize;
+    }
+
+    /// @brief Returns true if ptr is a live object of this pool.
+    bool owns(const T* ptr) const
+    {
+        size_t index = indexOf(reinterpret_cast<const Slot*>(ptr));
+        return index != kNone && isUsed(index);
     }
 
     size_t usedCount() const
@@ -112,16 +191,79 @@ public:
         return usedCount_;
     }
 
+    /// @brief Number of slots in the allocated chunks.
+    size_t capacity() const
+    {
+        return chunks_.size() * ChunkSize;
+    }
+
 private:
+    Slot& slotAt(size_t index)
+    {
+        return chunks_[index / ChunkSize]->slots[index % ChunkSize];
+    }
+
+    size_t indexOf(const Slot* ptr) const
+    {
+        auto it = std::upper_bound(chunksByAddress_.begin(), chunksByAddress_.end(), ptr,
+                                   [](const Slot* p, const std::pair<const Slot*, size_t>& chunk)
+                                   {
+                                       return std::less<const Slot*>()(p, chunk.first);
+                                   });
+        if (it == chunksByAddress_.begin())
+        {
+            return kNone;
+        }
+
+        --it;
+        if (!std::less<const Slot*>()(ptr, it->first + ChunkSize))
+        {
+            return kNone;
+        }
+        return it->second * ChunkSize + static_cast<size_t>(ptr - it->first);
+    }
+
     bool isUsed(size_t index) const
     {
-        size_t current = freeHead_;
-        while (current < PoolSize)
+        size_t offset = index % ChunkSize;
+        return (chunks_[index / ChunkSize]->used[offset / kWordBits] >> (offset % kWordBits)) & 1;
+    }
+
+    void markUsed(size_t index, bool used)
+    {
+        size_t offset = index % ChunkSize;
+        uint64_t& word = chunks_[index / ChunkSize]->used[offset / kWordBits];
+        uint64_t bit = uint64_t{1} << (offset % kWordBits);
+        word = used ? (word | bit) : (word & ~bit);
+    }
+
+    // Pushes the slots of chunk c on the free list so that they are handed out in address order.
+    void linkChunk(size_t c)
+    {
+        size_t base = c * ChunkSize;
+        for (size_t i = ChunkSize; i-- > 0;)
+        {
+            slotAt(base + i).nextFree = freeHead_;
+            freeHead_ = base + i;
+        }
+    }
+
+    bool addChunk()
+    {
+        try
         {
-            if (current == index)
-                return false;
-            current = pool_[current].nextFree;
+            chunks_.reserve(chunks_.size() + 1);
+            chunksByAddress_.reserve(chunks_.size() + 1);
+            chunks_.emplace_back(new Chunk());
         }
+        catch (const std::bad_alloc&)
+        {
+            return false;
+        }
+
+        std::pair<const Slot*, size_t> entry(chunks_.back()->slots.data(), chunks_.size() - 1);
+        chunksByAddress_.insert(std::upper_bound(chunksByAddress_.begin(), chunksByAddress_.end(), entry), entry);
+        linkChunk(chunks_.size() - 1);
         return true;
     }
 };
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <system_error>
 #include <atomic>
 #include <memory>
 #include <chrono>
+#include <casket/types/timer_wheel.hpp>
 
 namespace casket
 {
@@ -20,7 +22,10 @@ enum class EventType : uint32_t
     Error = 1 << 2,
     HangUp = 1 << 3,
     Invalid = 1 << 4,
-    EdgeTriggered = 1 << 5 // epoll only
+    EdgeTriggered = 1 << 5, // epoll only
+    Completion = 1 << 6,    // io_uring only, the event reports a finished recv or send
+    OneShot = 1 << 7,       // disarmed after one event until the next modify()
+    Exclusive = 1 << 8      // epoll only, add() only: wake one of the pollers sharing the fd
 };
 
 inline EventType operator|(EventType a, EventType b)
@@ -33,18 +38,35 @@ inline EventType operator&(EventType a, EventType b)
     return static_cast<EventType>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
 }
 
+inline EventType operator~(EventType a)
+{
+    return static_cast<EventType>(~static_cast<uint32_t>(a));
+}
+
 inline EventType& operator|=(EventType& a, EventType b)
 {
     a = a | b;
     return a;
 }
 
+/// @brief One entry of PollerBase::addBatch() and modifyBatch().
+struct PollRegistration
+{
+    int fd{-1};
+    EventType events{EventType::None};
+    void* userData{nullptr};
+};
+
 struct PollEvent
 {
     int fd{-1};
     void* userData{nullptr};
     EventType events{EventType::None};
     EventType revents{EventType::None};
+    /// Completion events only: received bytes, valid until the next wait().
+    const uint8_t* data{nullptr};
+    /// Completion events only: transferred byte count or a negated errno.
+    int32_t result{0};
 };
 
 template <typename Derived>
@@ -85,11 +107,58 @@ public:
         derived()->removeImpl(fd, ec);
     }
 
+    /// @brief Registers every entry in order, stopping at the first failure.
+    /// @return number of entries registered, ec describes the entry that failed.
+    size_t addBatch(const PollRegistration* items, size_t count, std::error_code& ec) noexcept
+    {
+        ec.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            derived()->addPtrImpl(items[i].userData, items[i].fd, items[i].events, ec);
+            if (ec)
+            {
+                return i;
+            }
+        }
+        return count;
+    }
+
+    /// @brief Updates every entry in order, stopping at the first failure.
+    /// @details Entries whose interest set did not change cost no system call, except for OneShot
+    ///          registrations, which modify() re-arms.
+    /// @return number of entries updated, ec describes the entry that failed.
+    size_t modifyBatch(const PollRegistration* items, size_t count, std::error_code& ec) noexcept
+    {
+        ec.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            derived()->modifyPtrImpl(items[i].userData, items[i].fd, items[i].events, ec);
+            if (ec)
+            {
+                return i;
+            }
+        }
+        return count;
+    }
+
     int wait(PollEvent* events, int maxCount, int timeoutMs, std::error_code& ec) noexcept
     {
         return derived()->waitImpl(events, maxCount, timeoutMs, ec);
     }
 
+    /// @brief Waits for events no longer than the next timer expiry, then fires due timers.
+    /// @details Timers fire before the caller sees the collected events, so their callbacks must not release
+    ///          anything those events refer to. A loop whose timers may close connections should wait with
+    ///          nextTimeoutMs() and advance the wheel after dispatching instead. Exceptions of callbacks propagate.
+    /// @param[in] timers wheel driven by this event loop.
+    /// @param[in] maxTimeoutMs upper bound of the wait, -1 waits until an event or a timer.
+    int wait(PollEvent* events, int maxCount, TimerWheel& timers, int maxTimeoutMs, std::error_code& ec)
+    {
+        int ret = wait(events, maxCount, timers.nextTimeoutMs(maxTimeoutMs), ec);
+        timers.advance();
+        return ret;
+    }
+
     bool isValid() const noexcept
     {
         return derived()->isValidImpl();
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+
+#include <casket/pack/packer.hpp>
+#include <casket/pack/unpacker.hpp>
+
+namespace casket
+{
+
+/// @brief Message preceded by the correlation id of the request it belongs to.
+/// @details AsyncClient sends Correlated<Request> and matches Correlated<Response> replies by id, so a server
+///          answers with Correlated<Response>{request.id, response}, in any order.
+template <typename T>
+struct Correlated
+{
+    uint64_t id;
+    T message;
+
+    PackResult<Packer*> pack(Packer& packer) const
+    {
+        auto result = packer.pack(id);
+        if (!result)
+        {
+            return result;
+        }
+        return message.pack(packer);
+    }
+
+    static UnpackResult<Correlated> unpack(Unpacker& unpacker)
+    {
+        auto id = unpacker.unpackUInt64();
+        if (!id)
+        {
+            return UnpackResult<Correlated>(id.error());
+        }
+
+        auto message = T::unpack(unpacker);
+        if (!message)
+        {
+            return UnpackResult<Correlated>(message.error());
+        }
+        return Correlated{id.value(), std::move(message.value())};
+    }
+};
+
+} // namespace casket
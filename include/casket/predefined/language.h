@@ -146,4 +146,14 @@
     #define ELSE_CPP20_OR_LATER(...) __VA_ARGS__
 #endif
 
+#if defined __cpp_impl_coroutine && defined __has_include
+    #if __has_include(<coroutine>)
+        #define LANGUAGE_HAS_COROUTINES 1
+    #endif
+#endif
+
+#if !defined LANGUAGE_HAS_COROUTINES
+    #define LANGUAGE_HAS_COROUTINES 0
+#endif
+
 // clang-format on
\ No newline at end of file
@@ -0,0 +1,310 @@
+#pragma once
+#include <sys/eventfd.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <casket/multiplexing/epoll_poller.hpp>
+#include <casket/server/connection_handoff.hpp>
+#include <casket/server/generic_server.hpp>
+
+namespace casket
+{
+
+enum class WorkerSelection
+{
+    RoundRobin,      ///< Workers take turns.
+    LeastConnections ///< The worker with the fewest connected and queued clients.
+};
+
+struct AcceptorServerConfig
+{
+    GenericServerConfig worker;                             ///< Applied to every worker, placement included.
+    size_t workers{0};                                      ///< 0 selects one per hardware thread.
+    WorkerSelection selection{WorkerSelection::RoundRobin}; ///< How accepted clients are spread.
+    size_t acceptBatch{64};                                 ///< Connections accepted per listener wakeup.
+};
+
+/// @brief One thread accepts connections and hands them to worker event loops.
+/// @details Works for every transport, in particular UnixSocket where SO_REUSEPORT sharding is not available.
+///          The acceptor drains the listen backlog with accept4() in batches and passes descriptors through
+///          a per-worker ConnectionHandoff, notifying each worker once per batch. Workers are GenericServer
+///          instances without a listening socket, worker i uses placement index i and the acceptor index N.
+/// @note Handlers are shared and run concurrently on all worker threads.
+template <typename Transport>
+class AcceptorServer
+{
+public:
+    using Worker = GenericServer<Transport>;
+    using ConnectionHandler = typename Worker::ConnectionHandler;
+    using ErrorHandler = typename Worker::ErrorHandler;
+
+    explicit AcceptorServer(const AcceptorServerConfig& config = AcceptorServerConfig{})
+        : config_(config)
+        , stopFd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        if (stopFd_ < 0)
+        {
+            throw std::system_error(std::error_code(errno, std::system_category()), "Failed to create eventfd");
+        }
+
+        if (config_.workers == 0)
+        {
+            config_.workers = std::max(1u, std::thread::hardware_concurrency());
+        }
+        if (config_.acceptBatch == 0)
+        {
+            config_.acceptBatch = 1;
+        }
+
+        for (size_t i = 0; i < config_.workers; ++i)
+        {
+            GenericServerConfig workerConfig = config_.worker;
+            workerConfig.placementIndex = i;
+            handoffs_.push_back(std::make_unique<ConnectionHandoff>());
+            workers_.push_back(std::make_unique<Worker>(workerConfig));
+            workers_.back()->setHandoff(handoffs_.back().get());
+        }
+    }
+
+    ~AcceptorServer() noexcept
+    {
+        stop();
+        ::close(stopFd_);
+    }
+
+    AcceptorServer(const AcceptorServer&) = delete;
+    AcceptorServer& operator=(const AcceptorServer&) = delete;
+
+    bool listen(const std::string& address, int port, int backlog, std::error_code& ec)
+    {
+        if constexpr (std::is_same_v<Transport, UnixSocket>)
+        {
+            return listenTransport_.listen(address, backlog, ec);
+        }
+        else if constexpr (std::is_same_v<Transport, TcpSocket>)
+        {
+            return listenTransport_.listen(address, static_cast<uint16_t>(port), backlog, ec);
+        }
+        return false;
+    }
+
+    const Transport& getListenTransport() const
+    {
+        return listenTransport_;
+    }
+
+    void setConnectionHandler(ConnectionHandler handler)
+    {
+        for (auto& worker : workers_)
+        {
+            worker->setConnectionHandler(handler);
+        }
+    }
+
+    void setErrorHandler(ErrorHandler handler)
+    {
+        errorHandler_ = handler;
+        for (auto& worker : workers_)
+        {
+            worker->setErrorHandler(handler);
+        }
+    }
+
+    /// @brief Starts the worker threads and the acceptor thread.
+    void start()
+    {
+        if (acceptor_.joinable())
+        {
+            return;
+        }
+
+        for (auto& worker : workers_)
+        {
+            threads_.emplace_back([server = worker.get()]() { server->run(); });
+        }
+        acceptor_ = std::thread([this]() { acceptLoop(); });
+    }
+
+    /// @brief Stops the acceptor, lets workers serve their clients for up to drainTimeout and joins them.
+    void stop(std::chrono::milliseconds drainTimeout = std::chrono::milliseconds(0))
+    {
+        if (acceptor_.joinable())
+        {
+            uint64_t value = 1;
+            [[maybe_unused]] ssize_t n = ::write(stopFd_, &value, sizeof(value));
+            acceptor_.join();
+            n = ::read(stopFd_, &value, sizeof(value));
+        }
+        listenTransport_.close();
+
+        for (auto& worker : workers_)
+        {
+            worker->requestStop(drainTimeout);
+        }
+        for (auto& thread : threads_)
+        {
+            thread.join();
+        }
+        threads_.clear();
+    }
+
+    bool isRunning() const
+    {
+        return acceptor_.joinable();
+    }
+
+    size_t getWorkerCount() const
+    {
+        return workers_.size();
+    }
+
+    Worker& getWorker(size_t index)
+    {
+        return *workers_[index];
+    }
+
+    /// @brief Sums the statistics shards of all workers into out.
+    void aggregateStatistics(ServerStatistics& out) const
+    {
+        out.reset();
+        out.startTime = {};
+        for (const auto& worker : workers_)
+        {
+            out.accumulate(worker->getStatistics());
+        }
+    }
+
+    void printStatistics(std::ostream& os = std::cout) const
+    {
+        ServerStatistics total;
+        aggregateStatistics(total);
+        total.print(os);
+    }
+
+private:
+    void acceptLoop()
+    {
+        if (!config_.worker.placement.empty())
+        {
+            std::error_code ec;
+            thread::ApplyThreadPlacement(config_.worker.placement, workers_.size(), ec);
+            reportError(ec);
+        }
+
+        EpollPoller poller;
+        std::error_code ec;
+        poller.add(listenTransport_.getFd(), EventType::Readable, ec);
+        if (!ec)
+        {
+            poller.add(stopFd_, EventType::Readable, ec);
+        }
+        if (ec)
+        {
+            reportError(ec);
+            return;
+        }
+
+        std::vector<bool> notified(workers_.size());
+        PollEvent events[2];
+        for (;;)
+        {
+            int count = poller.wait(events, 2, -1, ec);
+            if (ec && ec != std::errc::interrupted)
+            {
+                reportError(ec);
+                return;
+            }
+
+            for (int i = 0; i < count; ++i)
+            {
+                if (events[i].fd == stopFd_)
+                {
+                    return;
+                }
+                acceptBatch(notified);
+            }
+        }
+    }
+
+    void acceptBatch(std::vector<bool>& notified)
+    {
+        std::fill(notified.begin(), notified.end(), false);
+
+        for (size_t accepted = 0; accepted < config_.acceptBatch; ++accepted)
+        {
+            std::error_code ec;
+            SocketType fd =
+                Accept4(listenTransport_.getFd(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC, ec);
+            if (fd < 0)
+            {
+                if (ec != std::errc::resource_unavailable_try_again && ec != std::errc::operation_would_block &&
+                    ec != std::errc::interrupted)
+                {
+                    reportError(ec);
+                }
+                break;
+            }
+
+            size_t worker = selectWorker();
+            if (!handoffs_[worker]->push(fd))
+            {
+                CloseSocket(fd);
+                reportError(std::make_error_code(std::errc::resource_unavailable_try_again));
+                continue;
+            }
+            notified[worker] = true;
+        }
+
+        for (size_t i = 0; i < notified.size(); ++i)
+        {
+            if (notified[i])
+            {
+                handoffs_[i]->notify();
+            }
+        }
+    }
+
+    size_t selectWorker()
+    {
+        if (config_.selection == WorkerSelection::RoundRobin)
+        {
+            return nextWorker_++ % workers_.size();
+        }
+
+        size_t best = 0;
+        size_t bestLoad = static_cast<size_t>(-1);
+        for (size_t i = 0; i < workers_.size(); ++i)
+        {
+            size_t load = workers_[i]->getClientCount() + handoffs_[i]->pending();
+            if (load < bestLoad)
+            {
+                best = i;
+                bestLoad = load;
+            }
+        }
+        return best;
+    }
+
+    void reportError(const std::error_code& ec)
+    {
+        if (ec && errorHandler_)
+        {
+            errorHandler_(ec);
+        }
+    }
+
+private:
+    AcceptorServerConfig config_;
+    Transport listenTransport_;
+    ErrorHandler errorHandler_;
+    std::vector<std::unique_ptr<ConnectionHandoff>> handoffs_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::thread acceptor_;
+    int stopFd_;
+    size_t nextWorker_{0};
+};
+
+} // namespace casket
@@ -0,0 +1,110 @@
+#pragma once
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+
+#include <casket/lock_free/lf_ring_buffer.hpp>
+#include <casket/transport/socket_ops.hpp>
+
+namespace casket
+{
+
+/// @brief Single-producer single-consumer channel passing accepted descriptors to a worker event loop.
+/// @details The producer pushes descriptors into a lock-free ring and then calls notify(), which bumps an
+///          eventfd the worker polls for readability. The worker reads the eventfd before popping, so a
+///          descriptor pushed after its pop always comes with a fresh wakeup.
+class ConnectionHandoff
+{
+public:
+    static constexpr size_t kCapacity = 1024;
+
+    ConnectionHandoff()
+        : eventFd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        if (eventFd_ < 0)
+        {
+            throw std::system_error(std::error_code(errno, std::system_category()), "Failed to create eventfd");
+        }
+    }
+
+    ~ConnectionHandoff() noexcept
+    {
+        // Descriptors nobody picked up are closed, their clients see a reset connection.
+        int fd;
+        while (ring_.try_pop(fd))
+        {
+            CloseSocket(fd);
+        }
+        ::close(eventFd_);
+    }
+
+    ConnectionHandoff(const ConnectionHandoff&) = delete;
+    ConnectionHandoff& operator=(const ConnectionHandoff&) = delete;
+
+    /// @brief Producer side, returns false if the ring is full.
+    bool push(SocketType fd) noexcept
+    {
+        if (!ring_.try_push(fd))
+        {
+            return false;
+        }
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// @brief Producer side, wakes the consumer after one or more push() calls.
+    void notify() noexcept
+    {
+        uint64_t one = 1;
+        ssize_t n;
+        do
+        {
+            n = ::write(eventFd_, &one, sizeof(one));
+        } while (n < 0 && errno == EINTR);
+    }
+
+    /// @brief Consumer side, clears the wakeup and pops up to maxCount descriptors.
+    /// @details Popped descriptors stay in pending() until adopted() confirms the consumer registered them.
+    size_t pop(SocketType* out, size_t maxCount) noexcept
+    {
+        uint64_t value;
+        while (::read(eventFd_, &value, sizeof(value)) < 0 && errno == EINTR)
+        {
+        }
+
+        size_t count = 0;
+        while (count < maxCount && ring_.try_pop(out[count]))
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    /// @brief Consumer side, count popped descriptors are now accounted for by the consumer.
+    void adopted(size_t count) noexcept
+    {
+        pending_.fetch_sub(count, std::memory_order_relaxed);
+    }
+
+    /// @brief Descriptors pushed but not yet adopted, an estimate when read from another thread.
+    size_t pending() const noexcept
+    {
+        return pending_.load(std::memory_order_relaxed);
+    }
+
+    int getEventFd() const noexcept
+    {
+        return eventFd_;
+    }
+
+private:
+    lf::RingBuffer<SocketType, kCapacity> ring_;
+    std::atomic<size_t> pending_{0};
+    int eventFd_;
+};
+
+} // namespace casket
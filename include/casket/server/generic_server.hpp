@@ -1,21 +1,31 @@
 #pragma once
+#include <sys/uio.h>
 
+#include <algorithm>
+#include <array>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <cassert>
+#include <cstring>
 
 #include <casket/transport/transport_base.hpp>
 #include <casket/transport/unix_socket.hpp>
 #include <casket/transport/tcp_socket.hpp>
+#include <casket/transport/buffer_pool.hpp>
 #include <casket/transport/byte_buffer.hpp>
+#include <casket/transport/mirrored_ring_buffer.hpp>
 
 #include <casket/pack/pack.hpp>
 
-#include <casket/multiplexing/epoll_poller.hpp>
+#include <casket/multiplexing/adaptive_poller.hpp>
+#include <casket/server/connection_handoff.hpp>
 #include <casket/types/fixed_object_pool.hpp>
 #include <casket/types/hash_table.hpp>
+#include <casket/types/timer_wheel.hpp>
+#include <casket/thread/placement.hpp>
 
 namespace casket
 {
@@ -32,6 +42,12 @@ struct ServerStatistics
     std::atomic<uint64_t> peakConnections{0};
     std::atomic<uint64_t> cacheHits{0};
     std::atomic<uint64_t> cacheMisses{0};
+    /// Bucket i counts accepts that took less than 2^i microseconds from the listener wakeup, the last
+    /// bucket takes everything slower.
+    std::array<std::atomic<uint64_t>, 16> acceptLatencyBuckets{};
+    std::atomic<uint64_t> acceptWakeups{0};
+    std::atomic<uint64_t> totalAcceptLatencyNs{0};
+    std::atomic<uint64_t> maxAcceptLatencyNs{0};
     std::chrono::steady_clock::time_point startTime;
 
     void reset()
@@ -46,6 +62,13 @@ struct ServerStatistics
         peakConnections = 0;
         cacheHits = 0;
         cacheMisses = 0;
+        for (auto& bucket : acceptLatencyBuckets)
+        {
+            bucket = 0;
+        }
+        acceptWakeups = 0;
+        totalAcceptLatencyNs = 0;
+        maxAcceptLatencyNs = 0;
         startTime = std::chrono::steady_clock::now();
     }
 
@@ -95,6 +118,82 @@ struct ServerStatistics
         ++cacheMisses;
     }
 
+    void recordAcceptWakeup()
+    {
+        ++acceptWakeups;
+    }
+
+    void recordAcceptLatency(std::chrono::nanoseconds latency)
+    {
+        auto ns = static_cast<uint64_t>(latency.count());
+        size_t bucket = 0;
+        for (uint64_t us = ns / 1000; us > 0 && bucket + 1 < acceptLatencyBuckets.size(); us >>= 1)
+        {
+            ++bucket;
+        }
+        acceptLatencyBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        totalAcceptLatencyNs.fetch_add(ns, std::memory_order_relaxed);
+
+        uint64_t peak = maxAcceptLatencyNs.load(std::memory_order_relaxed);
+        while (ns > peak && !maxAcceptLatencyNs.compare_exchange_weak(peak, ns, std::memory_order_relaxed))
+            ;
+    }
+
+    /// @brief Upper bound in microseconds of the bucket holding the given fraction of accepts, 0 if none.
+    uint64_t getAcceptLatencyPercentileUs(double fraction) const
+    {
+        uint64_t total = 0;
+        for (const auto& bucket : acceptLatencyBuckets)
+        {
+            total += bucket.load();
+        }
+        if (total == 0)
+        {
+            return 0;
+        }
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < acceptLatencyBuckets.size(); ++i)
+        {
+            seen += acceptLatencyBuckets[i].load();
+            if (seen >= fraction * total)
+            {
+                return uint64_t{1} << i;
+            }
+        }
+        return uint64_t{1} << (acceptLatencyBuckets.size() - 1);
+    }
+
+    /// @brief Adds the counters of other, used to aggregate the shards of a multi-reactor server.
+    /// @note peakConnections becomes the sum of the shard peaks, an upper bound of the overall peak.
+    void accumulate(const ServerStatistics& other)
+    {
+        totalConnections += other.totalConnections.load();
+        activeConnections += other.activeConnections.load();
+        totalDisconnections += other.totalDisconnections.load();
+        totalBytesReceived += other.totalBytesReceived.load();
+        totalBytesSent += other.totalBytesSent.load();
+        totalMessagesProcessed += other.totalMessagesProcessed.load();
+        totalErrors += other.totalErrors.load();
+        peakConnections += other.peakConnections.load();
+        cacheHits += other.cacheHits.load();
+        cacheMisses += other.cacheMisses.load();
+        for (size_t i = 0; i < acceptLatencyBuckets.size(); ++i)
+        {
+            acceptLatencyBuckets[i] += other.acceptLatencyBuckets[i].load();
+        }
+        acceptWakeups += other.acceptWakeups.load();
+        totalAcceptLatencyNs += other.totalAcceptLatencyNs.load();
+        if (other.maxAcceptLatencyNs.load() > maxAcceptLatencyNs.load())
+        {
+            maxAcceptLatencyNs = other.maxAcceptLatencyNs.load();
+        }
+        if (startTime.time_since_epoch().count() == 0 || other.startTime < startTime)
+        {
+            startTime = other.startTime;
+        }
+    }
+
     double getCacheHitRate() const
     {
         uint64_t hits = cacheHits.load();
@@ -138,6 +237,11 @@ struct ServerStatistics
            << "Cache hit rate: " << std::fixed << std::setprecision(2) << (getCacheHitRate() * 100) << "%\n"
            << "Cache hits: " << cacheHits.load() << "\n"
            << "Cache misses: " << cacheMisses.load() << "\n"
+           << "Accepts per wakeup: " << std::setprecision(2)
+           << (acceptWakeups.load() > 0 ? static_cast<double>(totalConnections.load()) / acceptWakeups.load() : 0)
+           << "\n"
+           << "Accept latency p50/p99: <" << getAcceptLatencyPercentileUs(0.5) << " us / <"
+           << getAcceptLatencyPercentileUs(0.99) << " us, max " << maxAcceptLatencyNs.load() / 1000 << " us\n"
            << "\nPerformance metrics:\n"
            << "  Messages/sec: " << std::setprecision(0) << (uptime > 0 ? messages / uptime : 0) << " msg/s\n"
            << "  Throughput (recv): " << std::setprecision(2) << (uptime > 0 ? received / (uptime * 1024 * 1024) : 0)
@@ -153,27 +257,57 @@ struct GenericServerConfig
     size_t byteBufferSize{8192};
     size_t contextPoolSize{1024};
     std::chrono::seconds idleTimeout{10};
+    std::chrono::milliseconds idleCheckInterval{1000}; ///< Period of the idle connection sweep.
     std::chrono::seconds cacheTTL{60};
     int maxEvents{64};
     int waitTimeoutMs{100};
     bool enableStatistics{true};
+    thread::ThreadPlacement placement; ///< Applied to the event-loop thread by run().
+    size_t placementIndex{0};          ///< Index of the event-loop thread within placement.
+    PollerBackend pollerBackend{PollerBackend::Epoll}; ///< IoUring falls back to epoll if unsupported.
+    /// io_uring only: clients receive through a multishot recv into provided buffers, see Context::completionRecv.
+    bool completionIo{false};
+    uint16_t providedBuffers{256};      ///< Buffers of byteBufferSize bytes in the provided buffer ring.
+    size_t acceptBatch{64};             ///< Connections accepted per listener wakeup before polling again.
+    size_t maxReadBufferSize{1 << 20};  ///< Upper bound of a client read buffer, hence of a single frame.
+    size_t maxWriteBufferSize{4 << 20}; ///< Upper bound of the output queued for one client.
+    /// Clients borrow buffers from a shared pool only while data is in flight instead of owning them.
+    bool lazyBuffers{true};
+    /// Lazy buffers only, bytes of lent buffers, their growth and the output queued past them, reads pause
+    /// at the limit. Never less than two buffers, 0 is unlimited.
+    size_t bufferMemoryLimit{0};
 };
 
-template <typename Transport>
+/// @tparam Buffer ByteBuffer or MirroredRingBuffer.
+template <typename Transport, typename Buffer = ByteBuffer>
 struct Context
 {
     Transport transport;
-    ByteBuffer readBuffer;
-    ByteBuffer writeBuffer;
+    Buffer readBuffer;
+    Buffer writeBuffer;
     std::chrono::steady_clock::time_point lastActivity;
     bool active{false};
+    /// The server fills readBuffer from io_uring completions, handlers must not recv from the transport.
+    bool completionRecv{false};
+    /// Writable is part of the registered interest set.
+    bool writeInterest{false};
+    /// Set by the framing layer or a handler, the server closes the client once the handler returns.
+    bool closeRequested{false};
+    size_t maxReadBufferSize{0};  ///< 0 keeps the read buffer at its initial capacity.
+    size_t maxWriteBufferSize{0}; ///< 0 keeps the write buffer at its initial capacity, see enqueue().
+    /// The server flushes the output of this client at the end of the current step.
+    bool flushScheduled{false};
+    /// Readable is dropped from the interest set until the buffer pool has room again.
+    bool readPaused{false};
+    /// Bytes held past the pooled buffers, charged to the server's buffer pool.
+    size_t chargedMemory{0};
 
     uint64_t bytesReceived{0};
     uint64_t bytesSent{0};
     uint64_t messagesProcessed{0};
 
-    Context<Transport>* activePrev{nullptr};
-    Context<Transport>* activeNext{nullptr};
+    Context* activePrev{nullptr};
+    Context* activeNext{nullptr};
 
     Context(Context&& other) noexcept = default;
     Context& operator=(Context&& other) noexcept = default;
@@ -189,9 +323,14 @@ struct Context
 
     bool hasDataToWrite() const
     {
-        return writeBuffer.availableRead() > 0;
+        return writeBuffer.availableRead() > 0 || !outQueue_.empty();
     }
 
+    /// @brief Bytes queued for sending, writeBuffer included.
+    size_t pendingOutput() const noexcept
+    {
+        return writeBuffer.availableRead() + queuedBytes_;
+    }
     int getFd() const
     {
         return transport.getFd();
@@ -202,31 +341,121 @@ struct Context
         lastActivity = std::chrono::steady_clock::now();
     }
 
+    void updateActivity(std::chrono::steady_clock::time_point now)
+    {
+        lastActivity = now;
+    }
+
     bool isActive() const
     {
         return active;
     }
 
+    /// @brief Attaches the context to the list its server flushes at the end of every step.
+    void setFlushList(std::vector<Context*>* list) noexcept
+    {
+        flushList_ = list;
+    }
+
+    /// @brief Makes the server send the queued output at the end of the current step.
+    /// @details Called by packThenSend() and enqueue(), so output queued outside a connection handler, e.g. from
+    ///          a timer callback on the loop thread, is sent as well. Does nothing for a context without server.
+    void scheduleFlush()
+    {
+        if (flushList_ && !flushScheduled && hasDataToWrite())
+        {
+            flushScheduled = true;
+            flushList_->push_back(this);
+        }
+    }
+
+    /// @brief Queues a packed message, the server sends all output of a client once per step.
+    /// @details writeBuffer grows on demand up to maxWriteBufferSize, beyond that no_buffer_space is reported.
     template <typename T>
     bool packThenSend(const T& message, std::error_code& ec)
     {
-        Packer packer(writeBuffer.getWritePtr(), writeBuffer.availableWrite());
+        if (!outQueue_.empty())
+        {
+            bool packed = packIntoQueue(message, ec);
+            scheduleFlush();
+            return packed;
+        }
 
-        if (!message.pack(packer))
+        for (;;)
         {
-            return false;
+            Packer packer(writeBuffer.getWritePtr(), writeBuffer.availableWrite());
+            if (message.pack(packer))
+            {
+                writeBuffer.commitWrite(packer.position());
+                scheduleFlush();
+                return true;
+            }
+            if (!growWriteBuffer(ec))
+            {
+                return false;
+            }
         }
+    }
 
-        size_t packedSize = packer.position();
-        writeBuffer.commitWrite(packedSize);
+    /// @brief Queues payload as its own segment after everything queued so far, without copying it.
+    bool enqueue(std::vector<uint8_t>&& payload, std::error_code& ec)
+    {
+        if (pendingOutput() + payload.size() > maxOutput())
+        {
+            ec = std::make_error_code(std::errc::no_buffer_space);
+            return false;
+        }
+        if (!payload.empty())
+        {
+            queuedBytes_ += payload.size();
+            outQueue_.push_back(std::move(payload));
+            scheduleFlush();
+        }
+        return true;
+    }
 
-        ssize_t n = transport.sendBuffer(writeBuffer, ec);
-        if (n > 0)
+    /// @brief Sends queued output with one sendmsg() per round until it is gone or the socket is full.
+    /// @return bytes sent, ec is clear when the socket would block.
+    ssize_t flush(std::error_code& ec)
+    {
+        ssize_t total = 0;
+        while (hasDataToWrite())
         {
+            iovec iov[kMaxFlushSegments];
+            int count = 0;
+            if (writeBuffer.availableRead() > 0)
+            {
+                iov[count++] = {const_cast<uint8_t*>(writeBuffer.getReadPtr()), writeBuffer.availableRead()};
+            }
+            size_t offset = headOffset_;
+            for (auto it = outQueue_.begin(); it != outQueue_.end() && count < kMaxFlushSegments; ++it)
+            {
+                iov[count++] = {it->data() + offset, it->size() - offset};
+                offset = 0;
+            }
+
+            msghdr msg{};
+            msg.msg_iov = iov;
+            msg.msg_iovlen = static_cast<size_t>(count);
+            ssize_t n = transport.sendmsg(&msg, 0, ec);
+            if (n < 0 && ec == std::errc::interrupted)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                if (ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block)
+                {
+                    ec.clear();
+                }
+                break;
+            }
+
+            consumeOutput(static_cast<size_t>(n));
             bytesSent += n;
-            return true;
+            total += n;
         }
-        return false;
+        return total;
     }
 
     template <typename T>
@@ -234,6 +463,11 @@ struct Context
     {
         if (readBuffer.availableRead() == 0)
         {
+            if (completionRecv)
+            {
+                return UnpackResult<T>(UnpackerError::PrematureEnd);
+            }
+
             ssize_t n = transport.recvBuffer(readBuffer, ec);
             if (n <= 0)
             {
@@ -256,6 +490,41 @@ struct Context
         return result;
     }
 
+    /// @brief Drains the socket until EAGAIN and calls handler for every complete message in readBuffer.
+    /// @details Messages are self-delimiting pack streams, a partial frame stays buffered until the next call.
+    ///          The buffer grows up to maxReadBufferSize; when it is full and no message completes the client
+    ///          is closed with message_size, a malformed message closes it with bad_message. The message is
+    ///          only valid during handler, views into readBuffer are invalidated afterwards.
+    /// @return number of messages dispatched.
+    template <typename T, typename Handler>
+    size_t readThenUnpackAll(Handler&& handler, std::error_code& ec)
+    {
+        size_t dispatched = 0;
+        for (;;)
+        {
+            bool full = !completionRecv && fillReadBuffer(ec);
+            size_t count = unpackBuffered<T>(handler, ec);
+            dispatched += count;
+
+            if (ec || !full)
+            {
+                break;
+            }
+            if (count == 0)
+            {
+                ec = std::make_error_code(std::errc::message_size);
+                closeRequested = true;
+                break;
+            }
+        }
+        return dispatched;
+    }
+
+    void requestClose() noexcept
+    {
+        closeRequested = true;
+    }
+
     void reset()
     {
         transport = Transport();
@@ -266,21 +535,183 @@ struct Context
         messagesProcessed = 0;
         lastActivity = std::chrono::steady_clock::now();
         active = false;
+        completionRecv = false;
+        writeInterest = false;
+        closeRequested = false;
+        flushScheduled = false;
+        readPaused = false;
+        chargedMemory = 0;
+        outQueue_.clear();
+        queuedBytes_ = 0;
+        headOffset_ = 0;
+    }
+
+private:
+    static constexpr int kMaxFlushSegments = 64;
+    static constexpr size_t kMinBufferSize = 4096; ///< First allocation of a buffer that starts detached.
+
+    size_t maxOutput() const noexcept
+    {
+        return std::max(maxWriteBufferSize, writeBuffer.capacity());
+    }
+
+    bool growWriteBuffer(std::error_code& ec)
+    {
+        size_t available = writeBuffer.availableWrite();
+        writeBuffer.compact();
+        if (writeBuffer.availableWrite() > available)
+        {
+            return true;
+        }
+        if (writeBuffer.capacity() >= maxOutput() - queuedBytes_)
+        {
+            ec = std::make_error_code(std::errc::no_buffer_space);
+            return false;
+        }
+        writeBuffer.expand(std::min(std::max(writeBuffer.capacity() * 2, kMinBufferSize), maxOutput() - queuedBytes_));
+        return true;
+    }
+
+    // Output order is writeBuffer first, then the queue, so once the queue is used packing appends to its tail.
+    template <typename T>
+    bool packIntoQueue(const T& message, std::error_code& ec)
+    {
+        auto& tail = outQueue_.back();
+        size_t used = tail.size();
+        size_t room = std::max(tail.capacity() - used, writeBuffer.capacity());
+        for (;;)
+        {
+            if (pendingOutput() + room > maxOutput())
+            {
+                room = maxOutput() - pendingOutput();
+            }
+            tail.resize(used + room);
+            Packer packer(tail.data() + used, room);
+            if (message.pack(packer))
+            {
+                tail.resize(used + packer.position());
+                queuedBytes_ += packer.position();
+                return true;
+            }
+            tail.resize(used);
+            if (pendingOutput() + room >= maxOutput())
+            {
+                ec = std::make_error_code(std::errc::no_buffer_space);
+                return false;
+            }
+            room *= 2;
+        }
+    }
+
+    void consumeOutput(size_t bytes)
+    {
+        size_t fromBuffer = std::min(bytes, writeBuffer.availableRead());
+        writeBuffer.commitRead(fromBuffer);
+        bytes -= fromBuffer;
+        queuedBytes_ -= bytes;
+
+        while (bytes > 0)
+        {
+            size_t left = outQueue_.front().size() - headOffset_;
+            if (bytes < left)
+            {
+                headOffset_ += bytes;
+                return;
+            }
+            bytes -= left;
+            outQueue_.pop_front();
+            headOffset_ = 0;
+        }
     }
+
+    // Reads until the socket runs dry, returns true if the buffer filled up at its limit first.
+    bool fillReadBuffer(std::error_code& ec)
+    {
+        for (;;)
+        {
+            if (readBuffer.availableWrite() == 0)
+            {
+                readBuffer.compact();
+            }
+            if (readBuffer.availableWrite() == 0)
+            {
+                if (readBuffer.capacity() >= maxReadBufferSize)
+                {
+                    return true;
+                }
+                readBuffer.expand(std::min(std::max(readBuffer.capacity() * 2, kMinBufferSize), maxReadBufferSize));
+            }
+
+            ssize_t n = transport.recvBuffer(readBuffer, ec);
+            if (n > 0)
+            {
+                bytesReceived += n;
+                continue;
+            }
+
+            if (ec == std::errc::interrupted)
+            {
+                continue;
+            }
+            if (ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block)
+            {
+                ec.clear();
+            }
+            else
+            {
+                // Orderly shutdown by the peer or a socket error.
+                closeRequested = true;
+            }
+            return false;
+        }
+    }
+
+    template <typename T, typename Handler>
+    size_t unpackBuffered(Handler& handler, std::error_code& ec)
+    {
+        size_t count = 0;
+        while (readBuffer.availableRead() > 0)
+        {
+            Unpacker unpacker(readBuffer.getReadPtr(), readBuffer.availableRead());
+            auto result = T::unpack(unpacker);
+            if (!result)
+            {
+                if (result.error() != UnpackerError::PrematureEnd)
+                {
+                    ec = std::make_error_code(std::errc::bad_message);
+                    closeRequested = true;
+                }
+                break;
+            }
+
+            handler(*result);
+            readBuffer.commitRead(unpacker.position());
+            ++messagesProcessed;
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    std::deque<std::vector<uint8_t>> outQueue_; ///< Segments sent after writeBuffer.
+    size_t queuedBytes_{0};                     ///< Unsent bytes in outQueue_.
+    size_t headOffset_{0};                      ///< Bytes of the front segment already sent.
+    std::vector<Context*>* flushList_{nullptr}; ///< Flushed by the owning server, see scheduleFlush().
 };
 
-template <typename Transport>
+template <typename Transport, typename Buffer = ByteBuffer>
 class GenericServer
 {
 public:
-    using ClientContext = Context<Transport>;
+    using ClientContext = Context<Transport, Buffer>;
     using ConnectionHandler = std::function<void(ClientContext&)>;
     using ErrorHandler = std::function<void(const std::error_code&)>;
     using StatisticsHandler = std::function<void(const ServerStatistics&)>;
 
     explicit GenericServer(const GenericServerConfig& config = GenericServerConfig{})
         : config_(config)
-        , contextPool_(config_.contextPoolSize, config_.byteBufferSize)
+        , bufferPool_(config_.byteBufferSize, config_.bufferMemoryLimit)
+        , contextPool_(config_.contextPoolSize, config_.lazyBuffers ? 0 : config_.byteBufferSize)
         , fdToContext_(config_.contextPoolSize)
         , activeHead_(nullptr)
         , activeTail_(nullptr)
@@ -297,18 +728,34 @@ public:
     }
 
     bool listen(const std::string& address, int port, int backlog, std::error_code& ec)
+    {
+        return listen(address, port, backlog, false, ec);
+    }
+
+    /// @param[in] reusePort TCP only, lets several servers listen on the same port, see MultiReactorServer.
+    bool listen(const std::string& address, int port, int backlog, bool reusePort, std::error_code& ec)
     {
         if constexpr (std::is_same_v<Transport, UnixSocket>)
         {
+            if (reusePort)
+            {
+                ec = std::make_error_code(std::errc::operation_not_supported);
+                return false;
+            }
             return listenTransport_.listen(address, backlog, ec);
         }
         else if constexpr (std::is_same_v<Transport, TcpSocket>)
         {
-            return listenTransport_.listen(address, port, backlog, ec);
+            return listenTransport_.listen(address, static_cast<uint16_t>(port), backlog, reusePort, ec);
         }
         return false;
     }
 
+    const Transport& getListenTransport() const
+    {
+        return listenTransport_;
+    }
+
     void setConnectionHandler(ConnectionHandler handler)
     {
         connectionHandler_ = std::move(handler);
@@ -343,6 +790,13 @@ public:
         statistics_.print(os);
     }
 
+    /// @brief Returns the timer wheel driven by the event loop.
+    /// @details Timer callbacks run on the event-loop thread from step().
+    TimerWheel& getTimers()
+    {
+        return timers_;
+    }
+
     void start()
     {
         if (!init())
@@ -359,8 +813,16 @@ public:
             return false;
         }
 
+        if (stopRequested_.load(std::memory_order_acquire) && !drain())
+        {
+            running_ = false;
+            return false;
+        }
+
         std::error_code ec;
-        int eventCount = poller_->wait(events_.data(), events_.size(), config_.waitTimeoutMs, ec);
+        int timeoutMs = timers_.nextTimeoutMs(config_.waitTimeoutMs);
+        int eventCount = poller_->wait(events_.data(), events_.size(), timeoutMs, ec);
+        loopNow_ = std::chrono::steady_clock::now();
 
         if (ec)
         {
@@ -381,22 +843,44 @@ public:
 
             if (event.fd == listenTransport_.getFd())
             {
-                acceptNewClient();
+                acceptNewClients();
+            }
+            else if (handoff_ && event.fd == handoff_->getEventFd())
+            {
+                acceptHandedOff();
             }
             else if (event.userData)
             {
                 auto* ctx = static_cast<ClientContext*>(event.userData);
-                handleClientEvents(ctx, event.revents);
+                if ((event.revents & EventType::Completion) != EventType::None)
+                {
+                    handleClientCompletion(ctx, event);
+                }
+                else
+                {
+                    handleClientEvents(ctx, event.revents);
+                }
             }
         }
 
-        cleanupIdleConnections();
-
+        // Timers run once the events are dispatched, the idle sweep may release contexts they refer to.
+        timers_.advance();
+        flushScheduled();
         return running_;
     }
 
     void run()
     {
+        if (!config_.placement.empty())
+        {
+            std::error_code ec;
+            thread::ApplyThreadPlacement(config_.placement, config_.placementIndex, ec);
+            if (ec && errorHandler_)
+            {
+                errorHandler_(ec);
+            }
+        }
+
         start();
 
         while (running_)
@@ -406,11 +890,28 @@ public:
                 break;
             }
         }
+
+        if (stopRequested_.load(std::memory_order_acquire))
+        {
+            stop();
+        }
+    }
+
+    /// @brief Asks the event loop to stop, safe to call from any thread.
+    /// @details The loop closes the listening socket at its next step and keeps serving connected
+    ///          clients until they disconnect or drainTimeout expires, then run() returns after stop().
+    void requestStop(std::chrono::milliseconds drainTimeout = std::chrono::milliseconds(0))
+    {
+        drainTimeoutMs_.store(drainTimeout.count(), std::memory_order_relaxed);
+        stopRequested_.store(true, std::memory_order_release);
     }
 
     void stop()
     {
         running_ = false;
+        stopRequested_ = false;
+        draining_ = false;
+        timers_.cancel(idleTimer_);
 
         if (poller_)
         {
@@ -418,19 +919,23 @@ public:
             poller_.reset();
         }
 
+        pausedReads_.clear();
         auto* ctx = activeHead_;
         while (ctx)
         {
+            detachBuffers(ctx, true);
             ctx->transport = Transport();
             ctx->active = false;
             ctx = ctx->activeNext;
         }
 
         fdToContext_.clear();
+        flushList_.clear();
         contextPool_.reset();
 
         activeHead_ = nullptr;
         activeTail_ = nullptr;
+        clientCount_ = 0;
 
         listenTransport_.close();
         initialized_ = false;
@@ -441,16 +946,23 @@ public:
         return running_;
     }
 
+    /// @brief Number of connected clients, safe to read from any thread.
     size_t getClientCount() const
     {
-        size_t count = 0;
-        auto* ctx = activeHead_;
-        while (ctx)
-        {
-            ++count;
-            ctx = ctx->activeNext;
-        }
-        return count;
+        return clientCount_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Buffers lent to clients, see GenericServerConfig::lazyBuffers; event-loop thread only.
+    const BufferPool<Buffer>& getBufferPool() const
+    {
+        return bufferPool_;
+    }
+
+    /// @brief Makes the server also serve connections accepted elsewhere and passed through handoff.
+    /// @details Call before start(). A server without a listening socket then acts as a pure worker.
+    void setHandoff(ConnectionHandoff* handoff)
+    {
+        handoff_ = handoff;
     }
 
 private:
@@ -461,7 +973,7 @@ private:
             return true;
         }
 
-        poller_ = std::make_unique<EpollPoller>();
+        poller_ = std::make_unique<AdaptivePoller>(config_.pollerBackend);
 
         if (!poller_->isValid())
         {
@@ -473,7 +985,27 @@ private:
         }
 
         std::error_code ec;
-        poller_->add(listenTransport_.getFd(), EventType::Readable, ec);
+        completionIo_ = false;
+        if (config_.completionIo && poller_->getIoUring())
+        {
+            // Without multishot recv (Linux < 6.0) clients are served through readiness events.
+            completionIo_ = poller_->getIoUring()->setupBufferRing(
+                config_.providedBuffers, static_cast<uint32_t>(config_.byteBufferSize), ec);
+            if (ec && errorHandler_)
+            {
+                errorHandler_(ec);
+            }
+            ec.clear();
+        }
+
+        if (listenTransport_.isValid())
+        {
+            poller_->add(listenTransport_.getFd(), EventType::Readable, ec);
+        }
+        if (!ec && handoff_)
+        {
+            poller_->add(handoff_->getEventFd(), EventType::Readable, ec);
+        }
 
         if (ec)
         {
@@ -485,25 +1017,77 @@ private:
         }
 
         events_.resize(config_.maxEvents);
+        loopNow_ = std::chrono::steady_clock::now();
+
+        idleTimer_.setCallback(
+            [this]()
+            {
+                cleanupIdleConnections();
+                timers_.schedule(idleTimer_, config_.idleCheckInterval);
+            });
+        timers_.schedule(idleTimer_, config_.idleCheckInterval);
 
         initialized_ = true;
         return true;
     }
 
-    void addToActive(ClientContext* ctx)
+    // Returns false once the drain is over.
+    bool drain()
     {
-        ctx->activePrev = nullptr;
-        ctx->activeNext = activeHead_;
+        auto now = std::chrono::steady_clock::now();
+        if (!draining_)
+        {
+            draining_ = true;
+            drainDeadline_ = now + std::chrono::milliseconds(drainTimeoutMs_.load(std::memory_order_relaxed));
+
+            if (listenTransport_.isValid())
+            {
+                std::error_code ec;
+                poller_->remove(listenTransport_.getFd(), ec);
+                listenTransport_.close();
+            }
+        }
 
-        if (activeHead_)
-            activeHead_->activePrev = ctx;
-        activeHead_ = ctx;
+        return activeHead_ != nullptr && now < drainDeadline_;
+    }
 
-        if (!activeTail_)
-            activeTail_ = ctx;
+    void addToActive(ClientContext* ctx)
+    {
+        clientCount_.fetch_add(1, std::memory_order_relaxed);
+        linkActiveTail(ctx);
     }
 
     void removeFromActive(ClientContext* ctx)
+    {
+        clientCount_.fetch_sub(1, std::memory_order_relaxed);
+        unlinkActive(ctx);
+    }
+
+    // Records activity at the loop time and moves the client to the most recently active end of the list.
+    void touch(ClientContext* ctx)
+    {
+        ctx->updateActivity(loopNow_);
+        if (ctx != activeTail_)
+        {
+            unlinkActive(ctx);
+            linkActiveTail(ctx);
+        }
+    }
+
+    void linkActiveTail(ClientContext* ctx)
+    {
+        ctx->activeNext = nullptr;
+        ctx->activePrev = activeTail_;
+
+        if (activeTail_)
+            activeTail_->activeNext = ctx;
+        activeTail_ = ctx;
+
+        if (!activeHead_)
+            activeHead_ = ctx;
+    }
+
+    void unlinkActive(ClientContext* ctx)
     {
         if (ctx->activePrev)
             ctx->activePrev->activeNext = ctx->activeNext;
@@ -527,25 +1111,69 @@ private:
     {
         if (ctx)
         {
+            detachBuffers(ctx, true);
             ctx->reset();
             contextPool_.release(ctx);
         }
     }
 
-    void acceptNewClient()
+    // Drains the backlog up to acceptBatch connections, the listener is level-triggered and reports the rest.
+    void acceptNewClients()
     {
-        std::error_code ec;
-        Transport clientTransport(listenTransport_.accept(ec));
+        auto wakeup = loopNow_;
+        if (config_.enableStatistics)
+        {
+            statistics_.recordAcceptWakeup();
+        }
 
-        if (!clientTransport.isValid())
+        size_t limit = config_.acceptBatch > 0 ? config_.acceptBatch : 1;
+        for (size_t accepted = 0; accepted < limit; ++accepted)
         {
-            if (errorHandler_)
-                errorHandler_(ec);
-            if (config_.enableStatistics)
-                statistics_.recordError();
-            return;
+            std::error_code ec;
+            Transport clientTransport(listenTransport_.accept(ec));
+
+            if (!clientTransport.isValid())
+            {
+                if (ec == std::errc::resource_unavailable_try_again || ec == std::errc::operation_would_block)
+                {
+                    return;
+                }
+                if (ec == std::errc::interrupted || ec == std::errc::connection_aborted)
+                {
+                    continue;
+                }
+
+                if (errorHandler_)
+                    errorHandler_(ec);
+                if (config_.enableStatistics)
+                    statistics_.recordError();
+                return;
+            }
+
+            if (registerClient(std::move(clientTransport)) && config_.enableStatistics)
+            {
+                statistics_.recordAcceptLatency(std::chrono::steady_clock::now() - wakeup);
+            }
         }
+    }
 
+    void acceptHandedOff()
+    {
+        SocketType fds[64];
+        size_t count;
+        while ((count = handoff_->pop(fds, sizeof(fds) / sizeof(fds[0]))) > 0)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                registerClient(Transport::adopt(fds[i], true));
+            }
+            handoff_->adopted(count);
+        }
+    }
+
+    bool registerClient(Transport&& clientTransport)
+    {
+        std::error_code ec;
         int clientFd = clientTransport.getFd();
 
         auto* ctx = acquireContext();
@@ -559,23 +1187,32 @@ private:
             {
                 statistics_.recordError();
             }
-            return;
+            return false;
         }
 
         ctx->transport = std::move(clientTransport);
+        ctx->setFlushList(&flushList_);
         ctx->active = true;
+        ctx->writeInterest = false;
+        ctx->closeRequested = false;
+        ctx->maxReadBufferSize = std::max(config_.maxReadBufferSize, config_.byteBufferSize);
+        ctx->maxWriteBufferSize = std::max(config_.maxWriteBufferSize, config_.byteBufferSize);
         ctx->readBuffer.clear();
         ctx->writeBuffer.clear();
         ctx->bytesReceived = 0;
         ctx->bytesSent = 0;
         ctx->messagesProcessed = 0;
-        ctx->updateActivity();
+        ctx->updateActivity(loopNow_);
 
         fdToContext_.insert(clientFd, ctx);
         addToActive(ctx);
 
-        EventType events = EventType::Readable | EventType::HangUp | EventType::EdgeTriggered;
-        poller_->add(static_cast<void*>(ctx), clientFd, events, ec);
+        poller_->add(static_cast<void*>(ctx), clientFd, clientEvents(false), ec);
+        if (!ec && completionIo_)
+        {
+            ctx->completionRecv = true;
+            poller_->getIoUring()->recvMultishot(clientFd, ec);
+        }
 
         if (ec)
         {
@@ -592,13 +1229,14 @@ private:
             fdToContext_.remove(clientFd);
             removeFromActive(ctx);
             releaseContext(ctx);
-            return;
+            return false;
         }
 
         if (config_.enableStatistics)
         {
             statistics_.recordConnection();
         }
+        return true;
     }
 
     void handleClientEvents(ClientContext* ctx, EventType revents)
@@ -625,60 +1263,210 @@ private:
         }
     }
 
-    void handleClientRead(ClientContext* ctx)
+    void handleClientCompletion(ClientContext* ctx, const PollEvent& event)
     {
-        if (connectionHandler_)
+        if (!ctx || !ctx->transport.isValid() || !ctx->active)
         {
-            connectionHandler_(*ctx);
+            return;
         }
 
-        if (ctx->writeBuffer.availableRead() > 0)
+        if ((event.revents & (EventType::Error | EventType::HangUp)) != EventType::None)
         {
-            std::error_code ec;
-            ssize_t sent = ctx->transport.sendBuffer(ctx->writeBuffer, ec);
-            
-            if (sent > 0)
+            removeClient(ctx->getFd());
+            return;
+        }
+
+        if ((event.revents & EventType::Readable) != EventType::None && event.data)
+        {
+            // The data has already been received, the memory limit cannot hold it back.
+            attachBuffers(ctx, true);
+            auto size = static_cast<size_t>(event.result);
+            if (ctx->readBuffer.availableWrite() < size)
+            {
+                ctx->readBuffer.compact();
+            }
+            if (ctx->readBuffer.availableWrite() < size)
             {
-                if (ctx->writeBuffer.availableRead() > 0)
+                if (ctx->readBuffer.availableRead() + size > ctx->maxReadBufferSize)
                 {
-                    updateEvents(ctx, true);
+                    removeClient(ctx->getFd());
+                    return;
                 }
+                ctx->readBuffer.expand(ctx->readBuffer.availableRead() + size);
             }
-            else if (ec == std::errc::resource_unavailable_try_again)
+            std::memcpy(ctx->readBuffer.getWritePtr(), event.data, size);
+            ctx->readBuffer.commitWrite(size);
+            ctx->bytesReceived += size;
+
+            handleClientRead(ctx);
+        }
+    }
+
+    void handleClientRead(ClientContext* ctx)
+    {
+        if (!attachBuffers(ctx, false))
+        {
+            setReadPaused(ctx, true);
+            return;
+        }
+
+        if (connectionHandler_)
+        {
+            connectionHandler_(*ctx);
+        }
+
+        if (ctx->closeRequested)
+        {
+            std::error_code ec;
+            ctx->flush(ec);
+            removeClient(ctx->transport.getFd());
+            return;
+        }
+
+        // Covers handlers that write into writeBuffer directly instead of through packThenSend().
+        ctx->scheduleFlush();
+
+        detachBuffers(ctx, false);
+        touch(ctx);
+    }
+
+    // Lazy buffers only: lends the missing buffers unless that would exceed the memory limit. A client already
+    // holding a partial message always proceeds, so clients stuck mid-message cannot starve the pool.
+    bool attachBuffers(ClientContext* ctx, bool force)
+    {
+        if (!config_.lazyBuffers)
+        {
+            return true;
+        }
+
+        bool needRead = !BufferPool<Buffer>::isAttached(ctx->readBuffer);
+        bool needWrite = !BufferPool<Buffer>::isAttached(ctx->writeBuffer);
+        if (!force && needRead && !bufferPool_.canLend(needRead + needWrite))
+        {
+            return false;
+        }
+
+        if (needRead)
+        {
+            bufferPool_.borrow(ctx->readBuffer);
+        }
+        if (needWrite)
+        {
+            bufferPool_.borrow(ctx->writeBuffer);
+        }
+        return true;
+    }
+
+    // Returns drained buffers to the pool, or all of them if force is set, and resumes paused readers.
+    void detachBuffers(ClientContext* ctx, bool force)
+    {
+        if (!config_.lazyBuffers)
+        {
+            return;
+        }
+
+        if (BufferPool<Buffer>::isAttached(ctx->readBuffer) && (force || ctx->readBuffer.isEmpty()))
+        {
+            bufferPool_.giveBack(ctx->readBuffer);
+        }
+        if (BufferPool<Buffer>::isAttached(ctx->writeBuffer) && (force || !ctx->hasDataToWrite()))
+        {
+            bufferPool_.giveBack(ctx->writeBuffer);
+        }
+
+        // Growth is charged once per step, the client that grew keeps running while others pause.
+        size_t grown = 0;
+        if (!force)
+        {
+            size_t pooled = bufferPool_.bufferCapacity();
+            for (const Buffer* buffer : {&ctx->readBuffer, &ctx->writeBuffer})
             {
-                updateEvents(ctx, true);
+                grown += buffer->capacity() > pooled ? buffer->capacity() - pooled : 0;
             }
-            else if (ec)
+            grown += ctx->pendingOutput() - ctx->writeBuffer.availableRead();
+        }
+        bufferPool_.recharge(ctx->chargedMemory, grown);
+
+        while (!pausedReads_.empty() && bufferPool_.canLend(2))
+        {
+            auto* paused = pausedReads_.front();
+            pausedReads_.pop_front();
+            if (paused->active && paused->readPaused)
             {
-                removeClient(ctx->transport.getFd());
-                return;
+                setReadPaused(paused, false);
             }
         }
-
-        ctx->updateActivity();
     }
 
-    void handleClientWrite(ClientContext* ctx)
+    // Dropping Readable applies back-pressure through the socket buffer, re-adding it with EPOLL_CTL_MOD
+    // reports data that arrived meanwhile.
+    void setReadPaused(ClientContext* ctx, bool paused)
     {
+        if (ctx->readPaused == paused)
+        {
+            return;
+        }
+
+        ctx->readPaused = paused;
+        if (paused)
+        {
+            pausedReads_.push_back(ctx);
+        }
+
         std::error_code ec;
+        poller_->modify(static_cast<void*>(ctx), ctx->getFd(), clientEvents(ctx->writeInterest, paused), ec);
+        if (ec && errorHandler_)
+        {
+            errorHandler_(ec);
+        }
+    }
 
-        if (ctx->writeBuffer.availableRead() > 0)
+    // Sends the output queued during this step, one sendmsg() per client however many responses it got.
+    void flushScheduled()
+    {
+        for (size_t i = 0; i < flushList_.size(); ++i)
         {
-            ctx->transport.sendBuffer(ctx->writeBuffer, ec);
+            auto* ctx = flushList_[i];
+            if (!ctx->active || !ctx->flushScheduled)
+            {
+                continue;
+            }
+            ctx->flushScheduled = false;
 
-            if (ec && ec != std::errc::resource_unavailable_try_again)
+            if (!ctx->writeInterest)
             {
-                removeClient(ctx->transport.getFd());
-                return;
+                flushClient(ctx);
             }
         }
+        flushList_.clear();
+    }
 
-        if (ctx->writeBuffer.availableRead() == 0)
+    // Writes until the socket is full, the remainder goes out on the next Writable event.
+    bool flushClient(ClientContext* ctx)
+    {
+        std::error_code ec;
+        ssize_t sent = ctx->flush(ec);
+        if (ec)
+        {
+            removeClient(ctx->transport.getFd());
+            return false;
+        }
+        if (sent > 0 && config_.enableStatistics)
         {
-            updateEvents(ctx, false);
+            statistics_.recordBytesSent(static_cast<size_t>(sent));
         }
 
-        ctx->updateActivity();
+        updateEvents(ctx, ctx->hasDataToWrite());
+        detachBuffers(ctx, false);
+        return true;
+    }
+
+    void handleClientWrite(ClientContext* ctx)
+    {
+        if (flushClient(ctx))
+        {
+            touch(ctx);
+        }
     }
 
     void removeClient(int fd)
@@ -693,6 +1481,11 @@ private:
         {
             std::error_code ec;
             poller_->remove(fd, ec);
+            if (completionIo_)
+            {
+                // The in-flight recv holds the socket open, cancel it now so the peer sees the close.
+                poller_->getIoUring()->flush(ec);
+            }
         }
 
         removeFromActive(ctx);
@@ -707,19 +1500,18 @@ private:
         }
     }
 
+    // The active list is in least recently active order, so only expired clients are visited.
     void cleanupIdleConnections()
     {
         auto now = std::chrono::steady_clock::now();
-        auto* ctx = activeHead_;
-
-        while (ctx)
+        while (activeHead_ && now - activeHead_->lastActivity > config_.idleTimeout)
         {
-            auto* next = ctx->activeNext;
-            if (now - ctx->lastActivity > config_.idleTimeout)
+            auto* ctx = activeHead_;
+            removeClient(ctx->getFd());
+            if (activeHead_ == ctx)
             {
-                removeClient(ctx->getFd());
+                break;
             }
-            ctx = next;
         }
     }
 
@@ -729,22 +1521,43 @@ private:
         assert(ctx->transport.isValid());
         assert(ctx->active);
 
-        std::error_code ec;
-        EventType events = EventType::Readable | EventType::HangUp | EventType::EdgeTriggered;
-
-        if (writable)
+        if (ctx->writeInterest == writable)
         {
-            events |= EventType::Writable;
+            return;
         }
 
-        poller_->modify(static_cast<void*>(ctx), ctx->getFd(), events, ec);
+        std::error_code ec;
+        poller_->modify(static_cast<void*>(ctx), ctx->getFd(), clientEvents(writable, ctx->readPaused), ec);
 
-        if (ec && errorHandler_)
+        if (!ec)
+        {
+            ctx->writeInterest = writable;
+        }
+        else if (errorHandler_)
         {
             errorHandler_(ec);
         }
     }
 
+    // With completion I/O input arrives through recv completions, readiness is only needed for writes.
+    EventType clientEvents(bool writable, bool readPaused = false) const noexcept
+    {
+        EventType events = EventType::HangUp | EventType::EdgeTriggered;
+        if (completionIo_)
+        {
+            events = EventType::EdgeTriggered;
+        }
+        else if (!readPaused)
+        {
+            events |= EventType::Readable;
+        }
+        if (writable)
+        {
+            events |= EventType::Writable;
+        }
+        return events;
+    }
+
 private:
     GenericServerConfig config_;
     Transport listenTransport_;
@@ -752,29 +1565,46 @@ private:
     ErrorHandler errorHandler_;
     StatisticsHandler statisticsHandler_;
 
-    std::unique_ptr<EpollPoller> poller_;
+    std::unique_ptr<AdaptivePoller> poller_;
     std::vector<PollEvent> events_;
+    std::vector<ClientContext*> flushList_; ///< Clients with output queued since the last flush.
+    BufferPool<Buffer> bufferPool_;
+    std::deque<ClientContext*> pausedReads_; ///< Clients waiting for the buffer pool, oldest first.
+
+    TimerWheel timers_;
+    TimerWheel::Timer idleTimer_;
 
     FixedObjectPool<ClientContext> contextPool_;
     HashTable<SocketType, ClientContext> fdToContext_;
 
+    /// Connected clients, least recently active first.
     ClientContext* activeHead_;
     ClientContext* activeTail_;
+    /// Time the last wait returned, shared by everything handled in that step.
+    std::chrono::steady_clock::time_point loopNow_;
+    std::atomic<size_t> clientCount_{0};
+    ConnectionHandoff* handoff_{nullptr};
 
     std::atomic_bool running_{false};
+    std::atomic_bool stopRequested_{false};
+    std::atomic<int64_t> drainTimeoutMs_{0};
+    bool draining_{false};
+    std::chrono::steady_clock::time_point drainDeadline_;
     bool initialized_{false};
+    bool completionIo_{false};
 
     ServerStatistics statistics_;
 };
 
-template <typename Transport>
-void printServerStats(const GenericServer<Transport>& server, std::ostream& os = std::cout)
+template <typename Transport, typename Buffer>
+void printServerStats(const GenericServer<Transport, Buffer>& server, std::ostream& os = std::cout)
 {
     server.printStatistics(os);
 }
 
-template <typename Transport>
-void enablePeriodicStats(GenericServer<Transport>& server, std::chrono::seconds interval, std::ostream& os = std::cout)
+template <typename Transport, typename Buffer>
+void enablePeriodicStats(GenericServer<Transport, Buffer>& server, std::chrono::seconds interval,
+                         std::ostream& os = std::cout)
 {
     static auto lastPrint = std::chrono::steady_clock::now();
     auto now = std::chrono::steady_clock::now();
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <casket/server/generic_server.hpp>
+
+namespace casket
+{
+
+/// @brief Runs one GenericServer per thread, each with its own SO_REUSEPORT listening socket.
+/// @details Every reactor owns its poller, context pool, timers and statistics shard, so reactors share
+///          nothing on the hot path and the kernel balances new connections between their sockets.
+///          Reactor i applies config.placement with index i, which pins reactors to the configured CPU sets.
+/// @note Handlers are shared and run concurrently on all reactor threads.
+template <typename Transport>
+class MultiReactorServer
+{
+public:
+    using Reactor = GenericServer<Transport>;
+    using ConnectionHandler = typename Reactor::ConnectionHandler;
+    using ErrorHandler = typename Reactor::ErrorHandler;
+
+    /// @param[in] reactors number of reactor threads, 0 selects one per hardware thread.
+    explicit MultiReactorServer(size_t reactors = 0, const GenericServerConfig& config = GenericServerConfig{})
+    {
+        if (reactors == 0)
+        {
+            reactors = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        reactors_.reserve(reactors);
+        for (size_t i = 0; i < reactors; ++i)
+        {
+            GenericServerConfig reactorConfig = config;
+            reactorConfig.placementIndex = i;
+            reactors_.push_back(std::make_unique<Reactor>(reactorConfig));
+        }
+    }
+
+    ~MultiReactorServer() noexcept
+    {
+        stop();
+    }
+
+    MultiReactorServer(const MultiReactorServer&) = delete;
+    MultiReactorServer& operator=(const MultiReactorServer&) = delete;
+
+    /// @brief Binds every reactor to address and port, port 0 binds all reactors to one kernel-chosen port.
+    bool listen(const std::string& address, int port, int backlog, std::error_code& ec)
+    {
+        static_assert(std::is_same_v<Transport, TcpSocket>, "SO_REUSEPORT sharding requires TcpSocket");
+
+        for (auto& reactor : reactors_)
+        {
+            if (!reactor->listen(address, port, backlog, true, ec))
+            {
+                return false;
+            }
+
+            if (port == 0)
+            {
+                port = reactor->getListenTransport().getLocalPort(ec);
+                if (ec)
+                {
+                    return false;
+                }
+            }
+        }
+
+        port_ = port;
+        return true;
+    }
+
+    int getPort() const
+    {
+        return port_;
+    }
+
+    void setConnectionHandler(ConnectionHandler handler)
+    {
+        for (auto& reactor : reactors_)
+        {
+            reactor->setConnectionHandler(handler);
+        }
+    }
+
+    void setErrorHandler(ErrorHandler handler)
+    {
+        for (auto& reactor : reactors_)
+        {
+            reactor->setErrorHandler(handler);
+        }
+    }
+
+    /// @brief Starts one thread per reactor running its event loop.
+    void start()
+    {
+        if (!threads_.empty())
+        {
+            return;
+        }
+
+        threads_.reserve(reactors_.size());
+        for (auto& reactor : reactors_)
+        {
+            threads_.emplace_back([server = reactor.get()]() { server->run(); });
+        }
+    }
+
+    /// @brief Stops accepting, lets reactors serve their clients for up to drainTimeout and joins them.
+    void stop(std::chrono::milliseconds drainTimeout = std::chrono::milliseconds(0))
+    {
+        for (auto& reactor : reactors_)
+        {
+            reactor->requestStop(drainTimeout);
+        }
+
+        for (auto& thread : threads_)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+        threads_.clear();
+    }
+
+    bool isRunning() const
+    {
+        return !threads_.empty();
+    }
+
+    size_t getReactorCount() const
+    {
+        return reactors_.size();
+    }
+
+    Reactor& getReactor(size_t index)
+    {
+        return *reactors_[index];
+    }
+
+    /// @brief Sums the statistics shards of all reactors into out.
+    void aggregateStatistics(ServerStatistics& out) const
+    {
+        out.reset();
+        out.startTime = {};
+        for (const auto& reactor : reactors_)
+        {
+            out.accumulate(reactor->getStatistics());
+        }
+    }
+
+    void printStatistics(std::ostream& os = std::cout) const
+    {
+        ServerStatistics total;
+        aggregateStatistics(total);
+        total.print(os);
+    }
+
+private:
+    std::vector<std::unique_ptr<Reactor>> reactors_;
+    std::vector<std::thread> threads_;
+    int port_{0};
+};
+
+} // namespace casket
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <memory>
+
+namespace casket::thread
+{
+
+/// @brief Read side of a cooperative cancellation flag.
+/// @details Long running tasks poll isCancelled() and return early once it is set.
+///          A default constructed token is never cancelled.
+class CancellationToken final
+{
+public:
+    CancellationToken() = default;
+
+    bool isCancelled() const noexcept
+    {
+        return state_ && state_->load(std::memory_order_acquire);
+    }
+
+private:
+    friend class CancellationSource;
+
+    explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> state) noexcept
+        : state_(std::move(state))
+    {
+    }
+
+    std::shared_ptr<const std::atomic<bool>> state_;
+};
+
+/// @brief Owner side of a cooperative cancellation flag.
+class CancellationSource final
+{
+public:
+    CancellationSource()
+        : state_(std::make_shared<std::atomic<bool>>(false))
+    {
+    }
+
+    void cancel() noexcept
+    {
+        state_->store(true, std::memory_order_release);
+    }
+
+    bool isCancelled() const noexcept
+    {
+        return state_->load(std::memory_order_acquire);
+    }
+
+    CancellationToken token() const
+    {
+        return CancellationToken(state_);
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> state_;
+};
+
+} // namespace casket::thread
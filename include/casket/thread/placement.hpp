@@ -0,0 +1,193 @@
+#pragma once
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <system_error>
+
+#include <casket/utils/error_code.hpp>
+
+namespace casket::thread
+{
+
+/// @brief Placement of a group of threads on CPUs and NUMA nodes.
+/// @details Thread i of the group uses cpuSets[i % cpuSets.size()]. When cpuSets is empty and a NUMA node is
+///          given, threads may run on any CPU of that node.
+struct ThreadPlacement
+{
+    std::string name;                      ///< Name prefix, the thread index is appended.
+    std::vector<std::vector<int>> cpuSets; ///< CPU sets assigned to threads round-robin.
+    int numaNode{-1};                      ///< NUMA node for CPUs and memory allocations, -1 disables binding.
+    bool realtime{false};                  ///< Run threads with SCHED_FIFO.
+    int realtimePriority{1};               ///< SCHED_FIFO priority, 1..99.
+
+    bool empty() const noexcept
+    {
+        return name.empty() && cpuSets.empty() && numaNode < 0 && !realtime;
+    }
+};
+
+/// @brief Parses a kernel CPU list such as "0-3,8,10-11".
+inline std::vector<int> ParseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    size_t pos = 0;
+
+    while (pos < list.size())
+    {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos)
+        {
+            end = list.size();
+        }
+
+        std::string range = list.substr(pos, end - pos);
+        size_t dash = range.find('-');
+        if (!range.empty() && range.find_first_not_of("0123456789-\n ") == std::string::npos)
+        {
+            int first = std::atoi(range.c_str());
+            int last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+            for (int cpu = first; cpu <= last; ++cpu)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        pos = end + 1;
+    }
+
+    return cpus;
+}
+
+/// @brief Returns the CPUs of a NUMA node as reported by sysfs.
+inline std::vector<int> GetNumaNodeCpus(int node, std::error_code& ec)
+{
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string list;
+
+    if (!file || !std::getline(file, list))
+    {
+        SetSystemError(ec, std::errc::no_such_device);
+        return {};
+    }
+
+    ec.clear();
+    return ParseCpuList(list);
+}
+
+inline void SetCurrentThreadName(const std::string& name, std::error_code& ec) noexcept
+{
+    // Linux limits thread names to 15 characters plus the terminator.
+    std::string truncated = name.substr(0, 15);
+    int ret = pthread_setname_np(pthread_self(), truncated.c_str());
+    ec = ret == 0 ? std::error_code() : std::error_code(ret, std::system_category());
+}
+
+inline void SetCurrentThreadAffinity(const std::vector<int>& cpus, std::error_code& ec) noexcept
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for (int cpu : cpus)
+    {
+        if (cpu < 0 || cpu >= CPU_SETSIZE)
+        {
+            SetSystemError(ec, std::errc::invalid_argument);
+            return;
+        }
+        CPU_SET(cpu, &set);
+    }
+
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    ec = ret == 0 ? std::error_code() : std::error_code(ret, std::system_category());
+}
+
+inline void SetCurrentThreadRealtime(int priority, std::error_code& ec) noexcept
+{
+    sched_param param{};
+    param.sched_priority = priority;
+
+    int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    ec = ret == 0 ? std::error_code() : std::error_code(ret, std::system_category());
+}
+
+/// @brief Prefers memory of the NUMA node for allocations made by the calling thread.
+inline void SetCurrentThreadMemoryNode(int node, std::error_code& ec) noexcept
+{
+    constexpr int kBitsPerWord = sizeof(unsigned long) * 8;
+    constexpr int kMaxNodes = 1024;
+
+    if (node < 0 || node >= kMaxNodes)
+    {
+        SetSystemError(ec, std::errc::invalid_argument);
+        return;
+    }
+
+    unsigned long mask[kMaxNodes / kBitsPerWord] = {};
+    mask[node / kBitsPerWord] = 1UL << (node % kBitsPerWord);
+
+    if (::syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, kMaxNodes + 1) != 0)
+    {
+        ec = GetLastSystemError();
+        return;
+    }
+    ec.clear();
+}
+
+/// @brief Applies the placement to the calling thread.
+/// @param[in] placement placement of the thread group.
+/// @param[in] index index of the calling thread within the group.
+/// @param[out] ec first error encountered, the remaining steps are still attempted.
+inline void ApplyThreadPlacement(const ThreadPlacement& placement, size_t index, std::error_code& ec) noexcept
+{
+    std::error_code stepError;
+    ec.clear();
+
+    auto keepFirst = [&ec, &stepError]()
+    {
+        if (stepError && !ec)
+        {
+            ec = stepError;
+        }
+    };
+
+    if (!placement.name.empty())
+    {
+        SetCurrentThreadName(placement.name + "-" + std::to_string(index), stepError);
+        keepFirst();
+    }
+
+    if (!placement.cpuSets.empty())
+    {
+        SetCurrentThreadAffinity(placement.cpuSets[index % placement.cpuSets.size()], stepError);
+        keepFirst();
+    }
+    else if (placement.numaNode >= 0)
+    {
+        auto cpus = GetNumaNodeCpus(placement.numaNode, stepError);
+        if (!stepError)
+        {
+            SetCurrentThreadAffinity(cpus, stepError);
+        }
+        keepFirst();
+    }
+
+    if (placement.numaNode >= 0)
+    {
+        SetCurrentThreadMemoryNode(placement.numaNode, stepError);
+        keepFirst();
+    }
+
+    if (placement.realtime)
+    {
+        SetCurrentThreadRealtime(placement.realtimePriority, stepError);
+        keepFirst();
+    }
+}
+
+} // namespace casket::thread
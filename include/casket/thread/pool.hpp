@@ -3,32 +3,61 @@
 #include <thread>
 #include <future>
 #include <functional>
-#include <casket/lock_free/queue.hpp>
+#include <mutex>
+#include <condition_variable>
 #include <iostream>
+#include <casket/predefined/language.h>
+#include <casket/thread/priority_task_queue.hpp>
+#include <casket/thread/cancellation.hpp>
+#include <casket/thread/placement.hpp>
+
+#if LANGUAGE_HAS_COROUTINES
+#include <coroutine>
+#endif
 
 namespace casket::thread
 {
 
+struct ThreadPoolConfig
+{
+    size_t threads{std::thread::hardware_concurrency()};
+    /// Time after which a waiting task is served ahead of higher priority classes (zero disables).
+    PriorityTaskQueue::WaitLimits maxWait{std::chrono::microseconds{0}, std::chrono::milliseconds{10},
+                                          std::chrono::milliseconds{100}};
+    /// Worker CPU affinity, names and scheduling policy.
+    ThreadPlacement placement;
+};
+
+enum class ShutdownMode
+{
+    Drain, ///< Run every queued task before the workers exit.
+    Cancel ///< Drop queued tasks and signal cancellation to running ones.
+};
+
 class ThreadPool final
 {
 public:
     explicit ThreadPool(std::size_t threads)
-        : stop_(false)
+        : ThreadPool(makeConfig(threads))
     {
-        for (std::size_t i = 0; i < threads; ++i)
+    }
+
+    explicit ThreadPool(const ThreadPoolConfig& config)
+        : tasks_(config.maxWait)
+        , stop_(false)
+        , activeTasks_(0)
+        , runningWorkers_(config.threads)
+        , placement_(config.placement)
+    {
+        for (std::size_t i = 0; i < config.threads; ++i)
         {
-            workers_.emplace_back([this] { this->workerThread(); });
+            workers_.emplace_back([this, i] { this->workerThread(i); });
         }
     }
 
     ~ThreadPool() noexcept
     {
-        addTask([this]() { this->stop_.store(true); });
-
-        for (auto& worker : workers_)
-        {
-            worker.join();
-        }
+        join();
     }
 
     ThreadPool(const ThreadPool&) = delete;
@@ -37,13 +66,45 @@ public:
     ThreadPool& operator=(const ThreadPool&) = delete;
     ThreadPool& operator=(ThreadPool&&) noexcept = delete;
 
-    void addTask(std::function<void()> task)
+    /// @brief Queues a task.
+    /// @return false if the pool is shut down, the task is dropped without running.
+    bool addTask(std::function<void()> task, TaskPriority priority = TaskPriority::Normal)
+    {
+        return addTask(std::move(task), priority, TaskClock::time_point::max());
+    }
+
+    bool addTask(std::function<void()> task, TaskPriority priority, TaskClock::time_point deadline)
     {
-        tasks_.push(std::move(task));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_)
+            {
+                return false;
+            }
+            tasks_.push(std::move(task), priority, deadline);
+        }
+        condition_.notify_one();
+        return true;
     }
 
     template <class Func, class... Args>
     auto add(Func&& func, Args&&... args) -> std::future<std::invoke_result_t<Func, Args...>>
+    {
+        return addWithDeadline(TaskPriority::Normal, TaskClock::time_point::max(), std::forward<Func>(func),
+                               std::forward<Args>(args)...);
+    }
+
+    template <class Func, class... Args>
+    auto addWithPriority(TaskPriority priority, Func&& func, Args&&... args)
+        -> std::future<std::invoke_result_t<Func, Args...>>
+    {
+        return addWithDeadline(priority, TaskClock::time_point::max(), std::forward<Func>(func),
+                               std::forward<Args>(args)...);
+    }
+
+    template <class Func, class... Args>
+    auto addWithDeadline(TaskPriority priority, TaskClock::time_point deadline, Func&& func, Args&&... args)
+        -> std::future<std::invoke_result_t<Func, Args...>>
     {
         using return_type = std::invoke_result_t<Func, Args...>;
 
@@ -51,27 +112,261 @@ public:
         auto task = std::make_shared<std::packaged_task<return_type()>>(future_work);
 
         auto result = task->get_future();
-        addTask([task]() { (*task)(); });
+        addTask([task]() { (*task)(); }, priority, deadline);
         return result;
     }
 
+#if LANGUAGE_HAS_COROUTINES
+    /// @brief Awaitable that resumes the awaiting coroutine on a worker thread.
+    /// @details If the pool is already shut down the coroutine continues on the calling thread.
+    ///          Coroutines still queued when shutdown(ShutdownMode::Cancel) runs are never resumed,
+    ///          so cancel only after they finished or let them observe getCancellationToken().
+    auto schedule(TaskPriority priority = TaskPriority::Normal) noexcept
+    {
+        struct Awaiter
+        {
+            ThreadPool& pool;
+            TaskPriority priority;
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                return pool.addTask([handle]() { handle.resume(); }, priority);
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+        };
+        return Awaiter{*this, priority};
+    }
+#endif
+
+    /// @brief Stops accepting tasks and wakes every worker.
+    /// @details In Drain mode workers exit once the queue is empty. In Cancel mode queued tasks are
+    ///          dropped, their futures report broken_promise, and the cancellation token is set.
+    ///          May be called repeatedly, a later Cancel upgrades an earlier Drain.
+    void shutdown(ShutdownMode mode = ShutdownMode::Drain)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            if (mode == ShutdownMode::Cancel)
+            {
+                cancellation_.cancel();
+                tasks_.clear();
+            }
+        }
+        condition_.notify_all();
+        idleCondition_.notify_all();
+    }
+
+    bool isShutdown() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stop_;
+    }
+
+    /// @brief Blocks until the queue is empty and no task is running.
+    void waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idleCondition_.wait(lock, [this] { return isIdle(); });
+    }
+
+    /// @brief Blocks until the pool is idle or the timeout expires.
+    /// @return true if the pool became idle.
+    template <typename Rep, typename Period>
+    bool waitIdle(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return idleCondition_.wait_for(lock, timeout, [this] { return isIdle(); });
+    }
+
+    /// @brief Waits for every worker to exit, requesting a drain shutdown if none was requested.
+    void join()
+    {
+        shutdown(stopMode());
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            idleCondition_.wait(lock, [this] { return runningWorkers_ == 0; });
+        }
+        joinWorkers();
+    }
+
+    /// @brief Waits up to the timeout for every worker to exit.
+    /// @return false if some workers are still running, they can be joined later.
+    template <typename Rep, typename Period>
+    bool join(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        shutdown(stopMode());
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!idleCondition_.wait_for(lock, timeout, [this] { return runningWorkers_ == 0; }))
+            {
+                return false;
+            }
+        }
+        joinWorkers();
+        return true;
+    }
+
+    /// @brief Returns a token that is cancelled by shutdown(ShutdownMode::Cancel).
+    CancellationToken getCancellationToken() const
+    {
+        return cancellation_.token();
+    }
+
+    /// @brief Returns the first error reported while applying the worker placement.
+    std::error_code getPlacementError() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return placementError_;
+    }
+
+    size_t active() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return activeTasks_;
+    }
+
+    size_t pending() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tasks_.size();
+    }
+
+    size_t pending(TaskPriority priority) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tasks_.size(priority);
+    }
+
+    size_t size() const noexcept
+    {
+        return workers_.size();
+    }
+
+    const TaskClassStatistics& getStatistics(TaskPriority priority) const noexcept
+    {
+        return tasks_.getStatistics(priority);
+    }
+
+    void resetStatistics() noexcept
+    {
+        for (size_t i = 0; i < kTaskPriorityCount; ++i)
+        {
+            tasks_.getStatistics(static_cast<TaskPriority>(i)).reset();
+        }
+    }
+
+    void printStatistics(std::ostream& os = std::cout) const
+    {
+        os << "\n=== ThreadPool Statistics ===\n";
+        for (size_t i = 0; i < kTaskPriorityCount; ++i)
+        {
+            auto priority = static_cast<TaskPriority>(i);
+            const auto& stats = tasks_.getStatistics(priority);
+
+            os << "[" << toString(priority) << "] submitted: " << stats.submitted.load()
+               << ", dispatched: " << stats.dispatched.load() << ", promoted: " << stats.promoted.load()
+               << ", deadline missed: " << stats.deadlineMissed.load() << "\n";
+            os << "  queue depth: ";
+            stats.queueDepth.print(os, "");
+            os << "  wait time: ";
+            stats.waitTimeUs.print(os, "us");
+        }
+    }
+
 private:
-    void workerThread()
+    static ThreadPoolConfig makeConfig(std::size_t threads)
+    {
+        ThreadPoolConfig config;
+        config.threads = threads;
+        return config;
+    }
+
+    bool isIdle() const noexcept
     {
-        do
+        return tasks_.empty() && activeTasks_ == 0;
+    }
+
+    ShutdownMode stopMode() const noexcept
+    {
+        return cancellation_.isCancelled() ? ShutdownMode::Cancel : ShutdownMode::Drain;
+    }
+
+    void joinWorkers()
+    {
+        std::lock_guard<std::mutex> lock(joinMutex_);
+        for (auto& worker : workers_)
         {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+    }
+
+    void workerThread(size_t index)
+    {
+        std::error_code ec;
+        if (!placement_.empty())
+        {
+            ApplyThreadPlacement(placement_, index, ec);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (ec && !placementError_)
+        {
+            placementError_ = ec;
+        }
+
+        while (true)
+        {
+            condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+
+            if (tasks_.empty())
+            {
+                break;
+            }
+
             auto task = tasks_.pop();
-            if (task.has_value())
+            ++activeTasks_;
+            lock.unlock();
+
+            task();
+            task = nullptr;
+
+            lock.lock();
+            --activeTasks_;
+            if (isIdle())
             {
-                task.value()();
+                idleCondition_.notify_all();
             }
-        } while (!stop_.load());
+        }
+
+        --runningWorkers_;
+        idleCondition_.notify_all();
     }
 
 private:
     std::vector<std::thread> workers_;
-    lock_free::Queue<std::function<void()>> tasks_;
-    std::atomic<bool> stop_;
+    mutable std::mutex mutex_;
+    std::mutex joinMutex_;
+    std::condition_variable condition_;
+    std::condition_variable idleCondition_;
+    PriorityTaskQueue tasks_;
+    CancellationSource cancellation_;
+    bool stop_;
+    size_t activeTasks_;
+    size_t runningWorkers_;
+    const ThreadPlacement placement_;
+    std::error_code placementError_;
 };
 
-} // namespace casket::thread
\ No newline at end of file
+} // namespace casket::thread
@@ -0,0 +1,271 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <casket/utils/histogram.hpp>
+
+namespace casket::thread
+{
+
+using TaskClock = std::chrono::steady_clock;
+
+/// @brief Task priority classes, from the most to the least latency-critical.
+enum class TaskPriority : uint8_t
+{
+    High = 0,
+    Normal = 1,
+    Low = 2
+};
+
+static constexpr size_t kTaskPriorityCount = 3;
+
+inline const char* toString(TaskPriority priority) noexcept
+{
+    switch (priority)
+    {
+    case TaskPriority::High:
+        return "high";
+    case TaskPriority::Normal:
+        return "normal";
+    case TaskPriority::Low:
+        return "low";
+    }
+    return "unknown";
+}
+
+/// @brief Per-class scheduling statistics.
+struct TaskClassStatistics
+{
+    Log2Histogram queueDepth;  ///< Queue depth sampled on every submission.
+    Log2Histogram waitTimeUs;  ///< Time between submission and start of execution, in microseconds.
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> dispatched{0};
+    std::atomic<uint64_t> promoted{0};       ///< Dispatched ahead of higher classes by starvation protection.
+    std::atomic<uint64_t> deadlineMissed{0}; ///< Dispatched after their deadline had already passed.
+
+    void reset() noexcept
+    {
+        queueDepth.reset();
+        waitTimeUs.reset();
+        submitted = 0;
+        dispatched = 0;
+        promoted = 0;
+        deadlineMissed = 0;
+    }
+};
+
+/// @brief Multi-class task queue with earliest-deadline-first ordering inside each class.
+/// @details Tasks without a deadline are ordered FIFO after all deadline tasks of the same class.
+///          A class is served ahead of higher classes once its oldest task has waited longer than the
+///          class wait limit, and that task runs first, so background work cannot starve indefinitely
+///          behind higher classes or behind deadline tasks of its own class.
+/// @note Not thread-safe, the owner serializes access.
+class PriorityTaskQueue final
+{
+public:
+    using Task = std::function<void()>;
+    using WaitLimits = std::array<std::chrono::microseconds, kTaskPriorityCount>;
+
+    /// @brief Constructs a queue.
+    /// @param[in] waitLimits per-class starvation limits, zero disables promotion for the class.
+    explicit PriorityTaskQueue(const WaitLimits& waitLimits = WaitLimits{})
+        : waitLimits_(waitLimits)
+    {
+    }
+
+    PriorityTaskQueue(const PriorityTaskQueue&) = delete;
+    PriorityTaskQueue& operator=(const PriorityTaskQueue&) = delete;
+
+    void push(Task task, TaskPriority priority, TaskClock::time_point deadline = TaskClock::time_point::max(),
+              TaskClock::time_point now = TaskClock::now())
+    {
+        auto index = static_cast<size_t>(priority);
+        auto& heap = classes_[index];
+
+        arrivals_[index].push_back(Arrival{sequence_, now});
+        heap.push_back(Entry{deadline, now, sequence_++, std::move(task)});
+        std::push_heap(heap.begin(), heap.end(), Later{});
+        ++size_;
+
+        auto& stats = statistics_[index];
+        stats.submitted.fetch_add(1, std::memory_order_relaxed);
+        stats.queueDepth.record(heap.size());
+    }
+
+    /// @brief Extracts the next task to run.
+    /// @param[in] now current time used for starvation and deadline accounting.
+    /// @return task or empty function if the queue is empty.
+    Task pop(TaskClock::time_point now = TaskClock::now())
+    {
+        if (size_ == 0)
+        {
+            return Task();
+        }
+
+        size_t selected = kTaskPriorityCount;
+        for (size_t i = 0; i < kTaskPriorityCount; ++i)
+        {
+            if (!classes_[i].empty())
+            {
+                selected = i;
+                break;
+            }
+        }
+
+        bool promoted = false;
+        for (size_t i = selected + 1; i < kTaskPriorityCount; ++i)
+        {
+            const auto& arrivals = arrivals_[i];
+            if (!arrivals.empty() && waitLimits_[i].count() > 0 && now - arrivals.front().enqueued >= waitLimits_[i])
+            {
+                selected = i;
+                promoted = true;
+                break;
+            }
+        }
+
+        auto& heap = classes_[selected];
+        if (promoted)
+        {
+            // The oldest task is rarely on top, e.g. behind deadline tasks, so it is taken out of the middle.
+            uint64_t oldest = arrivals_[selected].front().sequence;
+            auto it = std::find_if(heap.begin(), heap.end(), [oldest](const Entry& e) { return e.sequence == oldest; });
+            std::iter_swap(it, heap.end() - 1);
+            Entry entry = std::move(heap.back());
+            heap.pop_back();
+            std::make_heap(heap.begin(), heap.end(), Later{});
+            return dispatch(selected, std::move(entry), true, now);
+        }
+
+        std::pop_heap(heap.begin(), heap.end(), Later{});
+        Entry entry = std::move(heap.back());
+        heap.pop_back();
+        return dispatch(selected, std::move(entry), false, now);
+    }
+
+    /// @brief Drops every queued task without running it.
+    /// @return number of dropped tasks.
+    size_t clear()
+    {
+        size_t dropped = size_;
+        for (size_t i = 0; i < kTaskPriorityCount; ++i)
+        {
+            classes_[i].clear();
+            arrivals_[i].clear();
+            departed_[i].clear();
+        }
+        size_ = 0;
+        return dropped;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t size(TaskPriority priority) const noexcept
+    {
+        return classes_[static_cast<size_t>(priority)].size();
+    }
+
+    const TaskClassStatistics& getStatistics(TaskPriority priority) const noexcept
+    {
+        return statistics_[static_cast<size_t>(priority)];
+    }
+
+    TaskClassStatistics& getStatistics(TaskPriority priority) noexcept
+    {
+        return statistics_[static_cast<size_t>(priority)];
+    }
+
+private:
+    struct Entry
+    {
+        TaskClock::time_point deadline;
+        TaskClock::time_point enqueued;
+        uint64_t sequence;
+        Task task;
+    };
+
+    struct Arrival
+    {
+        uint64_t sequence;
+        TaskClock::time_point enqueued;
+    };
+
+    // Max-heap comparator that keeps the earliest deadline, then the oldest submission, on top.
+    struct Later
+    {
+        bool operator()(const Entry& lhs, const Entry& rhs) const noexcept
+        {
+            if (lhs.deadline != rhs.deadline)
+            {
+                return lhs.deadline > rhs.deadline;
+            }
+            return lhs.sequence > rhs.sequence;
+        }
+    };
+
+    Task dispatch(size_t index, Entry entry, bool promoted, TaskClock::time_point now)
+    {
+        --size_;
+        forget(index, entry.sequence);
+
+        auto& stats = statistics_[index];
+        stats.dispatched.fetch_add(1, std::memory_order_relaxed);
+        stats.waitTimeUs.record(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - entry.enqueued).count()));
+        if (promoted)
+        {
+            stats.promoted.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (entry.deadline < now)
+        {
+            stats.deadlineMissed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return std::move(entry.task);
+    }
+
+    // Drops a dispatched task from the arrival order. Tasks that leave out of order are remembered in a
+    // min-heap until every older task of the class is gone, so the front of arrivals stays the oldest queued one.
+    void forget(size_t index, uint64_t sequence)
+    {
+        auto& arrivals = arrivals_[index];
+        auto& departed = departed_[index];
+        if (arrivals.front().sequence != sequence)
+        {
+            departed.push_back(sequence);
+            std::push_heap(departed.begin(), departed.end(), std::greater<uint64_t>{});
+            return;
+        }
+
+        arrivals.pop_front();
+        while (!departed.empty() && departed.front() == arrivals.front().sequence)
+        {
+            std::pop_heap(departed.begin(), departed.end(), std::greater<uint64_t>{});
+            departed.pop_back();
+            arrivals.pop_front();
+        }
+    }
+
+    std::array<std::vector<Entry>, kTaskPriorityCount> classes_;
+    std::array<std::deque<Arrival>, kTaskPriorityCount> arrivals_; ///< Enqueue order of queued tasks.
+    std::array<std::vector<uint64_t>, kTaskPriorityCount> departed_; ///< Sequences dispatched ahead of older ones.
+    std::array<TaskClassStatistics, kTaskPriorityCount> statistics_;
+    WaitLimits waitLimits_;
+    uint64_t sequence_{0};
+    size_t size_{0};
+};
+
+} // namespace casket::thread
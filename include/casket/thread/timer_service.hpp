@@ -0,0 +1,146 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <casket/types/timer_wheel.hpp>
+#include <casket/thread/placement.hpp>
+
+namespace casket::thread
+{
+
+/// @brief Runs delayed callbacks on a dedicated thread driven by a TimerWheel.
+/// @details Callbacks run on the service thread without the internal lock held, so they may schedule
+///          or cancel other timers. Long callbacks delay every later timer.
+class TimerService final
+{
+public:
+    using Clock = TimerWheel::Clock;
+    using Callback = TimerWheel::Callback;
+
+    explicit TimerService(Clock::duration resolution = std::chrono::milliseconds(1),
+                          ThreadPlacement placement = ThreadPlacement{})
+        : wheel_(resolution)
+        , placement_(std::move(placement))
+    {
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~TimerService() noexcept
+    {
+        stop();
+    }
+
+    TimerService(const TimerService&) = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+    TimerHandle scheduleAfter(Clock::duration delay, Callback callback)
+    {
+        TimerHandle handle;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            handle = wheel_.scheduleAfter(delay, [this, callback = std::move(callback)]() mutable
+                                          { pending_->push_back(std::move(callback)); });
+        }
+        condition_.notify_one();
+        return handle;
+    }
+
+    TimerHandle scheduleAt(Clock::time_point when, Callback callback)
+    {
+        return scheduleAfter(when - Clock::now(), std::move(callback));
+    }
+
+    /// @brief Cancels a timer.
+    /// @return false if the timer has already fired or is running.
+    bool cancel(TimerHandle handle)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return wheel_.cancel(handle);
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return wheel_.size();
+    }
+
+    /// @brief Stops the service thread, timers that have not fired are dropped.
+    void stop() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        condition_.notify_one();
+
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+    }
+
+private:
+    void run()
+    {
+        if (!placement_.empty())
+        {
+            std::error_code ec;
+            ApplyThreadPlacement(placement_, 0, ec);
+        }
+
+        std::vector<Callback> ready;
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while (!stop_)
+        {
+            auto timeout = wheel_.nextTimeout();
+            if (timeout == Clock::duration::max())
+            {
+                condition_.wait(lock);
+            }
+            else if (timeout > Clock::duration::zero())
+            {
+                condition_.wait_for(lock, timeout);
+            }
+
+            if (stop_)
+            {
+                break;
+            }
+
+            collect(ready);
+            if (ready.empty())
+            {
+                continue;
+            }
+
+            lock.unlock();
+            for (auto& callback : ready)
+            {
+                callback();
+            }
+            ready.clear();
+            lock.lock();
+        }
+    }
+
+    // Fires due timers into a list so callbacks run without the lock.
+    void collect(std::vector<Callback>& ready)
+    {
+        pending_ = &ready;
+        wheel_.advance();
+        pending_ = nullptr;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    TimerWheel wheel_;
+    ThreadPlacement placement_;
+    std::vector<Callback>* pending_{nullptr};
+    std::thread thread_;
+    bool stop_{false};
+};
+
+} // namespace casket::thread
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace casket
+{
+
+/// @brief Shared pool of equally sized buffers lent to connections while they have data in flight.
+/// @details A detached buffer is a moved-from one with capacity 0, borrow() replaces it with a pooled buffer
+///          and giveBack() moves it back into the pool. Buffers may round bufferSize up, e.g. to the page size,
+///          so the capacity of the first buffer created is the one cached and counted against the limit. Buffers
+///          that grew past it are freed instead of cached, their owner charges the growth with recharge() so
+///          that it counts against the limit too. The limit is at least two buffers, a client needs one to read
+///          and one to write.
+/// @tparam Buffer ByteBuffer or MirroredRingBuffer.
+template <typename Buffer>
+class BufferPool
+{
+public:
+    /// @param[in] memoryLimit bytes that may be lent at once, 0 is unlimited.
+    BufferPool(size_t bufferSize, size_t memoryLimit)
+        : bufferSize_(bufferSize)
+        , memoryLimit_(memoryLimit)
+        , maxLent_(limitFor(bufferSize))
+    {
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /// @brief Whether count more buffers may be lent without exceeding the memory limit.
+    bool canLend(size_t count) const noexcept
+    {
+        size_t grownBuffers = (grown_ + bufferCapacity() - 1) / bufferCapacity();
+        return lent_ + count + grownBuffers <= maxLent_;
+    }
+
+    /// @brief Attaches a pooled buffer to target, which must be detached.
+    void borrow(Buffer& target)
+    {
+        if (free_.empty())
+        {
+            target = Buffer(bufferSize_);
+            if (capacity_ == 0)
+            {
+                capacity_ = target.capacity();
+                maxLent_ = limitFor(capacity_);
+            }
+        }
+        else
+        {
+            target = std::move(free_.back());
+            free_.pop_back();
+        }
+        ++lent_;
+    }
+
+    /// @brief Detaches the buffer of source and keeps it for the next borrow().
+    void giveBack(Buffer& source)
+    {
+        Buffer buffer(std::move(source));
+        buffer.clear();
+        if (buffer.capacity() == capacity_ && free_.size() < maxLent_)
+        {
+            free_.push_back(std::move(buffer));
+        }
+        --lent_;
+    }
+
+    /// @brief Charges bytes an owner holds past its pooled buffers, e.g. grown capacity, to the memory limit.
+    /// @param[in,out] charged bytes charged to this owner so far, set to bytes.
+    void recharge(size_t& charged, size_t bytes) noexcept
+    {
+        grown_ = grown_ - charged + bytes;
+        charged = bytes;
+    }
+
+    static bool isAttached(const Buffer& buffer) noexcept
+    {
+        return buffer.capacity() > 0;
+    }
+
+    size_t lentBuffers() const noexcept
+    {
+        return lent_;
+    }
+
+    size_t cachedBuffers() const noexcept
+    {
+        return free_.size();
+    }
+
+    /// @brief Capacity of a pooled buffer, bufferSize until the first one is created.
+    size_t bufferCapacity() const noexcept
+    {
+        return capacity_ ? capacity_ : bufferSize_;
+    }
+
+    /// @brief Bytes held by lent and cached buffers plus the growth charged with recharge().
+    size_t memoryUsage() const noexcept
+    {
+        return (lent_ + free_.size()) * bufferCapacity() + grown_;
+    }
+
+private:
+    size_t limitFor(size_t capacity) const noexcept
+    {
+        return memoryLimit_ == 0 ? static_cast<size_t>(-1) : std::max<size_t>(memoryLimit_ / capacity, 2);
+    }
+
+private:
+    size_t bufferSize_;
+    size_t memoryLimit_;
+    size_t capacity_{0}; ///< Capacity of the first buffer created, 0 until then.
+    size_t maxLent_;
+    size_t lent_{0};
+    size_t grown_{0}; ///< Bytes charged with recharge().
+    std::vector<Buffer> free_;
+};
+
+} // namespace casket
@@ -125,6 +125,21 @@ public:
         writePos_ = 0;
     }
 
+    /// @brief Moves unread data to the front so the whole free space is writable.
+    void compact() noexcept
+    {
+        if (readPos_ > 0)
+        {
+            size_t avail = availableRead();
+            if (avail > 0)
+            {
+                std::memmove(data_.data(), getReadPtr(), avail);
+            }
+            readPos_ = 0;
+            writePos_ = avail;
+        }
+    }
+
     void expand(size_type newCapacity)
     {
         if (newCapacity > data_.size())
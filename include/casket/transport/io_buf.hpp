@@ -0,0 +1,534 @@
+#pragma once
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <system_error>
+#include <vector>
+
+#include <casket/pack/packer.hpp>
+#include <casket/pack/unpacker.hpp>
+
+namespace casket
+{
+
+/// @brief Cache of fixed-size, reference counted blocks backing IOBuf chains.
+/// @details Requests larger than blockSize get a dedicated block that is freed instead of cached. The pool must
+///          outlive every IOBuf using it; pool, blocks and chains belong to one thread.
+class IOBufPool
+{
+public:
+    struct Block
+    {
+        IOBufPool* pool;
+        uint32_t refs;
+        size_t capacity;
+        size_t used; ///< Bytes written, only the slice ending here may append to the block.
+
+        uint8_t* data() noexcept
+        {
+            return reinterpret_cast<uint8_t*>(this + 1);
+        }
+    };
+
+    explicit IOBufPool(size_t blockSize = 4096, size_t maxCached = 256)
+        : blockSize_(blockSize)
+        , maxCached_(maxCached)
+    {
+        free_.reserve(maxCached_);
+    }
+
+    ~IOBufPool() noexcept
+    {
+        assert(outstanding_ == 0);
+        for (auto* block : free_)
+        {
+            ::operator delete(block);
+        }
+    }
+
+    IOBufPool(const IOBufPool&) = delete;
+    IOBufPool& operator=(const IOBufPool&) = delete;
+
+    /// @brief Returns a block with at least minCapacity bytes and one reference.
+    Block* acquire(size_t minCapacity)
+    {
+        Block* block;
+        if (minCapacity <= blockSize_ && !free_.empty())
+        {
+            block = free_.back();
+            free_.pop_back();
+        }
+        else
+        {
+            size_t capacity = std::max(minCapacity, blockSize_);
+            block = new (::operator new(sizeof(Block) + capacity)) Block{this, 0, capacity, 0};
+        }
+
+        block->refs = 1;
+        block->used = 0;
+        ++outstanding_;
+        return block;
+    }
+
+    static void retain(Block* block) noexcept
+    {
+        ++block->refs;
+    }
+
+    static void release(Block* block) noexcept
+    {
+        if (--block->refs == 0)
+        {
+            block->pool->recycle(block);
+        }
+    }
+
+    size_t blockSize() const noexcept
+    {
+        return blockSize_;
+    }
+
+    /// @brief Blocks handed out and still referenced.
+    size_t outstandingBlocks() const noexcept
+    {
+        return outstanding_;
+    }
+
+    size_t cachedBlocks() const noexcept
+    {
+        return free_.size();
+    }
+
+private:
+    void recycle(Block* block) noexcept
+    {
+        --outstanding_;
+        if (block->capacity == blockSize_ && free_.size() < maxCached_)
+        {
+            free_.push_back(block);
+            return;
+        }
+        ::operator delete(block);
+    }
+
+private:
+    size_t blockSize_;
+    size_t maxCached_;
+    size_t outstanding_{0};
+    std::vector<Block*> free_;
+};
+
+/// @brief Byte stream stored as a chain of slices of pooled blocks.
+/// @details Appending never moves buffered data and consuming never memmoves the rest. Copies, split() and
+///          append() of another chain share blocks by reference instead of copying bytes. Data is only copied
+///          when a caller needs it contiguous, see coalesce() and unpackFront().
+class IOBuf
+{
+public:
+    static constexpr size_t kMaxSegments = 64; ///< iovec entries passed to one sendmsg().
+
+    explicit IOBuf(IOBufPool& pool)
+        : pool_(&pool)
+    {
+    }
+
+    ~IOBuf() noexcept
+    {
+        clear();
+    }
+
+    IOBuf(const IOBuf& other)
+        : pool_(other.pool_)
+        , slices_(other.slices_)
+        , size_(other.size_)
+    {
+        for (auto& slice : slices_)
+        {
+            IOBufPool::retain(slice.block);
+        }
+    }
+
+    IOBuf& operator=(const IOBuf& other)
+    {
+        if (this != &other)
+        {
+            IOBuf copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    IOBuf(IOBuf&& other) noexcept
+        : pool_(other.pool_)
+        , slices_(std::move(other.slices_))
+        , size_(other.size_)
+    {
+        other.slices_.clear();
+        other.size_ = 0;
+    }
+
+    IOBuf& operator=(IOBuf&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            pool_ = other.pool_;
+            slices_ = std::move(other.slices_);
+            size_ = other.size_;
+            other.slices_.clear();
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    void swap(IOBuf& other) noexcept
+    {
+        std::swap(pool_, other.pool_);
+        slices_.swap(other.slices_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_t segmentCount() const noexcept
+    {
+        return slices_.size();
+    }
+
+    void clear() noexcept
+    {
+        for (auto& slice : slices_)
+        {
+            IOBufPool::release(slice.block);
+        }
+        slices_.clear();
+        size_ = 0;
+    }
+
+    /// @brief Writable space at the tail, at least minBytes, a new block is chained if the tail has less.
+    uint8_t* prepareWrite(size_t& available, size_t minBytes = 1)
+    {
+        if (!slices_.empty())
+        {
+            auto& tail = slices_.back();
+            size_t end = tail.offset + tail.length;
+            if (tail.block->used == end && tail.block->capacity - end >= minBytes)
+            {
+                available = tail.block->capacity - end;
+                return tail.block->data() + end;
+            }
+        }
+
+        trimEmptyTail();
+        auto* block = pool_->acquire(minBytes);
+        slices_.push_back({block, 0, 0});
+        available = block->capacity;
+        return block->data();
+    }
+
+    void commitWrite(size_t bytes) noexcept
+    {
+        auto& tail = slices_.back();
+        assert(tail.block->used == tail.offset + tail.length);
+        assert(tail.block->used + bytes <= tail.block->capacity);
+        tail.length += bytes;
+        tail.block->used += bytes;
+        size_ += bytes;
+    }
+
+    void append(const void* data, size_t size)
+    {
+        auto* bytes = static_cast<const uint8_t*>(data);
+        while (size > 0)
+        {
+            size_t available;
+            uint8_t* ptr = prepareWrite(available);
+            size_t count = std::min(available, size);
+            std::memcpy(ptr, bytes, count);
+            commitWrite(count);
+            bytes += count;
+            size -= count;
+        }
+    }
+
+    /// @brief Appends the data of other without copying it, both chains share the blocks.
+    void append(const IOBuf& other)
+    {
+        trimEmptyTail();
+        size_t count = other.slices_.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            Slice slice = other.slices_[i];
+            if (slice.length > 0)
+            {
+                IOBufPool::retain(slice.block);
+                slices_.push_back(slice);
+            }
+        }
+        size_ += other.size_;
+    }
+
+    void append(IOBuf&& other)
+    {
+        if (this == &other)
+        {
+            append(static_cast<const IOBuf&>(other));
+            return;
+        }
+
+        trimEmptyTail();
+        for (auto& slice : other.slices_)
+        {
+            slices_.push_back(slice);
+        }
+        size_ += other.size_;
+        other.slices_.clear();
+        other.size_ = 0;
+    }
+
+    /// @brief Drops bytes from the front, blocks are released once no slice refers to them.
+    void consume(size_t bytes) noexcept
+    {
+        assert(bytes <= size_);
+        size_ -= bytes;
+        while (!slices_.empty())
+        {
+            auto& front = slices_.front();
+            if (bytes < front.length)
+            {
+                front.offset += bytes;
+                front.length -= bytes;
+                return;
+            }
+            bytes -= front.length;
+            IOBufPool::release(front.block);
+            slices_.pop_front();
+        }
+    }
+
+    /// @brief Moves the first bytes into a new chain, a slice crossing the cut is shared by both.
+    IOBuf split(size_t bytes)
+    {
+        assert(bytes <= size_);
+        IOBuf head(*pool_);
+        head.size_ = bytes;
+        size_ -= bytes;
+
+        while (bytes > 0)
+        {
+            auto& front = slices_.front();
+            if (bytes < front.length)
+            {
+                IOBufPool::retain(front.block);
+                head.slices_.push_back({front.block, front.offset, bytes});
+                front.offset += bytes;
+                front.length -= bytes;
+                break;
+            }
+            bytes -= front.length;
+            head.slices_.push_back(front);
+            slices_.pop_front();
+        }
+        return head;
+    }
+
+    /// @brief Copies up to bytes bytes starting at offset, returns the number copied.
+    size_t copyTo(void* out, size_t bytes, size_t offset = 0) const noexcept
+    {
+        auto* dst = static_cast<uint8_t*>(out);
+        size_t copied = 0;
+        for (const auto& slice : slices_)
+        {
+            if (copied == bytes)
+            {
+                break;
+            }
+            if (offset >= slice.length)
+            {
+                offset -= slice.length;
+                continue;
+            }
+            size_t count = std::min(slice.length - offset, bytes - copied);
+            std::memcpy(dst + copied, slice.block->data() + slice.offset + offset, count);
+            copied += count;
+            offset = 0;
+        }
+        return copied;
+    }
+
+    /// @brief Makes the first bytes contiguous, copying them into one block only if they span several.
+    const uint8_t* coalesce(size_t bytes)
+    {
+        assert(bytes <= size_);
+        if (bytes == 0)
+        {
+            return nullptr;
+        }
+
+        auto& front = slices_.front();
+        if (front.length >= bytes)
+        {
+            return front.block->data() + front.offset;
+        }
+
+        auto* block = pool_->acquire(bytes);
+        copyTo(block->data(), bytes);
+        block->used = bytes;
+        consume(bytes);
+        slices_.push_front({block, 0, bytes});
+        size_ += bytes;
+        return block->data();
+    }
+
+    /// @brief Describes the buffered data as at most maxCount iovec entries, returns the number filled.
+    size_t fillIov(iovec* iov, size_t maxCount) const noexcept
+    {
+        size_t count = 0;
+        for (auto it = slices_.begin(); it != slices_.end() && count < maxCount; ++it)
+        {
+            if (it->length > 0)
+            {
+                iov[count++] = {it->block->data() + it->offset, it->length};
+            }
+        }
+        return count;
+    }
+
+    /// @brief Receives into the free tail space and one spare block with a single recvmsg().
+    /// @return bytes received, 0 with ec set if the socket would block and 0 with ec clear on EOF.
+    template <typename Transport>
+    ssize_t recvFrom(Transport& transport, std::error_code& ec)
+    {
+        size_t available;
+        uint8_t* tail = prepareWrite(available);
+        auto* spare = pool_->acquire(pool_->blockSize());
+
+        iovec iov[2] = {{tail, available}, {spare->data(), spare->capacity}};
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = 2;
+        ssize_t n = transport.recvmsg(&msg, 0, ec);
+
+        auto received = static_cast<size_t>(std::max<ssize_t>(n, 0));
+        commitWrite(std::min(received, available));
+        if (received > available)
+        {
+            spare->used = received - available;
+            slices_.push_back({spare, 0, spare->used});
+            size_ += spare->used;
+        }
+        else
+        {
+            IOBufPool::release(spare);
+        }
+        return n;
+    }
+
+    /// @brief Sends up to kMaxSegments slices with one sendmsg() and consumes what was sent.
+    template <typename Transport>
+    ssize_t sendTo(Transport& transport, std::error_code& ec)
+    {
+        iovec iov[kMaxSegments];
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = fillIov(iov, kMaxSegments);
+        if (msg.msg_iovlen == 0)
+        {
+            return 0;
+        }
+
+        ssize_t n = transport.sendmsg(&msg, 0, ec);
+        if (n > 0)
+        {
+            consume(static_cast<size_t>(n));
+        }
+        return n;
+    }
+
+    /// @brief Packs message at the tail, a message larger than the free space goes into a block of its own.
+    template <typename T>
+    bool pack(const T& message)
+    {
+        size_t available;
+        uint8_t* ptr = prepareWrite(available);
+        for (;;)
+        {
+            Packer packer(ptr, available);
+            auto result = message.pack(packer);
+            if (result)
+            {
+                commitWrite(packer.position());
+                return true;
+            }
+            if (result.error() != PackerError::BufferOverflow)
+            {
+                return false;
+            }
+            ptr = prepareWrite(available, available < pool_->blockSize() ? pool_->blockSize() : available * 2);
+        }
+    }
+
+    /// @brief Unpacks the message at the front, coalescing as much as it needs if it spans blocks.
+    /// @details Views in the result point into the chain and stay valid until the front is consumed.
+    ///          PrematureEnd means the buffered data ends inside the message.
+    /// @param[out] length bytes taken by the message, to be passed to consume().
+    template <typename T>
+    UnpackResult<T> unpackFront(size_t& length)
+    {
+        length = 0;
+        size_t window = slices_.empty() ? 0 : std::min(slices_.front().length, size_);
+        for (;;)
+        {
+            Unpacker unpacker(coalesce(window), window);
+            auto result = T::unpack(unpacker);
+            if (result)
+            {
+                length = unpacker.position();
+                return result;
+            }
+            if (result.error() != UnpackerError::PrematureEnd || window == size_)
+            {
+                return result;
+            }
+            window = std::min(size_, std::max(window * 2, pool_->blockSize()));
+        }
+    }
+
+private:
+    struct Slice
+    {
+        IOBufPool::Block* block;
+        size_t offset;
+        size_t length;
+    };
+
+    // An empty tail left by prepareWrite() must not end up between data slices.
+    void trimEmptyTail() noexcept
+    {
+        if (!slices_.empty() && slices_.back().length == 0)
+        {
+            IOBufPool::release(slices_.back().block);
+            slices_.pop_back();
+        }
+    }
+
+private:
+    IOBufPool* pool_;
+    std::deque<Slice> slices_;
+    size_t size_{0};
+};
+
+} // namespace casket
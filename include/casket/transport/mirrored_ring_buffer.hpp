@@ -0,0 +1,224 @@
+#pragma once
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+namespace casket
+{
+
+/// @brief Ring buffer whose memory is mapped twice back to back, so readable and writable regions are always
+///        contiguous even when they wrap around.
+/// @details Byte i and byte i + capacity() are the same memory, a pointer into the first mapping can be used for
+///          up to capacity() bytes. Nothing is ever memmoved: recv() writes straight behind the data and
+///          Unpacker parses messages straddling the wrap point in place. The interface mirrors ByteBuffer so it
+///          can be used as GenericServer and GenericClient buffer. Capacity is rounded up to the page size,
+///          a buffer of capacity 0 maps nothing until expand().
+class MirroredRingBuffer final
+{
+public:
+    using value_type = uint8_t;
+    using size_type = size_t;
+
+    explicit MirroredRingBuffer(size_type capacity)
+    {
+        map(capacity);
+    }
+
+    ~MirroredRingBuffer() noexcept
+    {
+        unmap();
+    }
+
+    MirroredRingBuffer(const MirroredRingBuffer&) = delete;
+    MirroredRingBuffer& operator=(const MirroredRingBuffer&) = delete;
+
+    MirroredRingBuffer(MirroredRingBuffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , head_(std::exchange(other.head_, 0))
+        , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    MirroredRingBuffer& operator=(MirroredRingBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            capacity_ = std::exchange(other.capacity_, 0);
+            head_ = std::exchange(other.head_, 0);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    value_type* getWritePtr() noexcept
+    {
+        return data_ + writePos();
+    }
+
+    const value_type* getReadPtr() const noexcept
+    {
+        return data_ + head_;
+    }
+
+    size_type availableRead() const noexcept
+    {
+        return size_;
+    }
+
+    size_type availableWrite() const noexcept
+    {
+        return capacity_ - size_;
+    }
+
+    size_type capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    void commitWrite(size_type bytes) noexcept
+    {
+        size_ += bytes;
+    }
+
+    void commitRead(size_type bytes) noexcept
+    {
+        size_ -= bytes;
+        head_ = size_ == 0 ? 0 : (head_ + bytes) % capacity_;
+    }
+
+    void clear() noexcept
+    {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    void reset() noexcept
+    {
+        clear();
+    }
+
+    /// @brief Free space is always contiguous, nothing to do.
+    void compact() noexcept
+    {
+    }
+
+    /// @brief Remaps with at least newCapacity bytes and copies the readable data once.
+    void expand(size_type newCapacity)
+    {
+        if (newCapacity <= capacity_)
+        {
+            return;
+        }
+
+        MirroredRingBuffer larger(newCapacity);
+        if (size_ > 0)
+        {
+            std::memcpy(larger.data_, getReadPtr(), size_);
+        }
+        larger.size_ = size_;
+        *this = std::move(larger);
+    }
+
+    value_type* prepareWrite(size_type& out)
+    {
+        out = availableWrite();
+        return getWritePtr();
+    }
+
+    const value_type* prepareRead(size_type& out) const noexcept
+    {
+        out = availableRead();
+        return getReadPtr();
+    }
+
+    size_type writePos() const noexcept
+    {
+        size_t end = head_ + size_;
+        return end >= capacity_ ? end - capacity_ : end;
+    }
+
+    size_type readPos() const noexcept
+    {
+        return head_;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+private:
+    void map(size_type capacity)
+    {
+        if (capacity == 0)
+        {
+            return;
+        }
+
+        size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        capacity_ = (capacity + page - 1) / page * page;
+
+        int fd = ::memfd_create("casket-ring", MFD_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::system_error(std::error_code(errno, std::system_category()), "Failed to create memfd");
+        }
+        if (::ftruncate(fd, static_cast<off_t>(capacity_)) < 0)
+        {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(std::error_code(error, std::system_category()), "Failed to size memfd");
+        }
+
+        // Reserve both halves first so the two mappings are guaranteed to be adjacent.
+        void* base = ::mmap(nullptr, 2 * capacity_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        int error = errno;
+        if (base != MAP_FAILED)
+        {
+            auto* bytes = static_cast<uint8_t*>(base);
+            if (::mmap(bytes, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+                ::mmap(bytes + capacity_, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) ==
+                    MAP_FAILED)
+            {
+                error = errno;
+                ::munmap(base, 2 * capacity_);
+                base = MAP_FAILED;
+            }
+        }
+        ::close(fd);
+
+        if (base == MAP_FAILED)
+        {
+            capacity_ = 0;
+            throw std::system_error(std::error_code(error, std::system_category()), "Failed to map ring buffer");
+        }
+        data_ = static_cast<uint8_t*>(base);
+    }
+
+    void unmap() noexcept
+    {
+        if (data_)
+        {
+            ::munmap(data_, 2 * capacity_);
+            data_ = nullptr;
+        }
+    }
+
+private:
+    uint8_t* data_{nullptr};
+    size_t capacity_{0};
+    size_t head_{0};
+    size_t size_{0};
+};
+
+} // namespace casket
@@ -100,6 +100,21 @@ inline SocketType Accept(SocketType sock, SocketAddrType* addr, SocketLengthType
     return ret;
 }
 
+/// @brief accept4(2), the flags (SOCK_NONBLOCK, SOCK_CLOEXEC) are applied atomically to the new socket.
+inline SocketType Accept4(SocketType sock, SocketAddrType* addr, SocketLengthType* addrlen, int flags,
+                          std::error_code& ec)
+{
+    assert(sock != g_InvalidSocket);
+
+    SocketType ret = ::accept4(sock, addr, addrlen, flags);
+    if (ret == g_InvalidSocket)
+    {
+        ec = GetLastSystemError();
+    }
+
+    return ret;
+}
+
 inline void SetNonBlocking(SocketType sock, bool value, std::error_code& ec)
 {
     assert(sock != g_InvalidSocket);
@@ -93,6 +93,13 @@ public:
     }
 
     bool listen(const std::string& address, uint16_t port, int backlog, std::error_code& ec)
+    {
+        return listen(address, port, backlog, false, ec);
+    }
+
+    /// @param[in] reusePort sets SO_REUSEPORT, the kernel then spreads connections over all sockets
+    ///            listening on the same address and port.
+    bool listen(const std::string& address, uint16_t port, int backlog, bool reusePort, std::error_code& ec)
     {
         fd_ = CreateSocket(AF_INET, SOCK_STREAM, 0, ec);
         if (fd_ < 0)
@@ -107,6 +114,12 @@ public:
             return false;
         }
 
+        if (reusePort && SetSocketOption(fd_, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt), ec) < 0)
+        {
+            closeImpl();
+            return false;
+        }
+
         isNonBlocking_ = true;
         SetNonBlocking(fd_, true, ec);
         if (ec)
@@ -138,6 +151,15 @@ public:
         return true;
     }
 
+    /// @brief Takes ownership of a connected descriptor, e.g. one accepted by another thread.
+    static TcpSocket adopt(SocketType fd, bool nonblock) noexcept
+    {
+        TcpSocket socket;
+        socket.fd_ = fd;
+        socket.isNonBlocking_ = nonblock;
+        return socket;
+    }
+
     TcpSocket accept(std::error_code& ec)
     {
         if (!isValidImpl())
@@ -146,23 +168,29 @@ public:
             return TcpSocket();
         }
 
-        SocketType clientFd = Accept(fd_, nullptr, nullptr, ec);
+        SocketType clientFd = Accept4(fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC, ec);
         if (clientFd < 0)
         {
             return TcpSocket();
         }
 
-        SetNonBlocking(clientFd, true, ec);
-        if (ec)
+        ec.clear();
+        return adopt(clientFd, true);
+    }
+
+    /// @brief Returns the port the socket is bound to, e.g. the one picked by the kernel for port 0.
+    uint16_t getLocalPort(std::error_code& ec) const
+    {
+        SocketAddrIn4Type addr{};
+        socklen_t length = sizeof(addr);
+        if (::getsockname(fd_, reinterpret_cast<SocketAddrType*>(&addr), &length) < 0)
         {
-            CloseSocket(clientFd);
-            return TcpSocket();
+            ec = GetLastSystemError();
+            return 0;
         }
 
-        TcpSocket client;
-        client.fd_ = clientFd;
-        client.isNonBlocking_ = true;
-        return client;
+        ec.clear();
+        return ntohs(addr.sin_port);
     }
 
 private:
@@ -220,6 +248,48 @@ private:
         return n;
     }
 
+    template <typename Buffer>
+    ssize_t recvBufferImpl(Buffer& buffer, std::error_code& ec) noexcept
+    {
+        size_t available;
+        uint8_t* ptr = buffer.prepareWrite(available);
+
+        if (available == 0)
+        {
+            buffer.expand(buffer.capacity() * 2);
+            ptr = buffer.prepareWrite(available);
+            if (available == 0)
+                return 0;
+        }
+        auto len = recvImpl(ptr, available, ec);
+
+        if (len > 0)
+        {
+            buffer.commitWrite(len);
+        }
+        return len;
+    }
+
+    template <typename Buffer>
+    ssize_t sendBufferImpl(Buffer& buffer, std::error_code& ec) noexcept
+    {
+        size_t available;
+        const uint8_t* ptr = buffer.prepareRead(available);
+
+        if (available == 0)
+        {
+            return 0;
+        }
+
+        auto len = sendImpl(ptr, available, ec);
+
+        if (len > 0)
+        {
+            buffer.commitRead(len);
+        }
+        return len;
+    }
+
     ssize_t sendmsgImpl(const struct msghdr* msg, int flags, std::error_code& ec)
     {
         if (!isValidImpl())
@@ -28,12 +28,15 @@ public:
         return derived().recvImpl(buffer, length, ec);
     }
 
-    ssize_t recvBuffer(ByteBuffer& buffer, std::error_code& ec) noexcept
+    /// @tparam Buffer ByteBuffer or a buffer with the same interface, e.g. MirroredRingBuffer.
+    template <typename Buffer>
+    ssize_t recvBuffer(Buffer& buffer, std::error_code& ec) noexcept
     {
         return derived().recvBufferImpl(buffer, ec);
     }
 
-    ssize_t sendBuffer(ByteBuffer& buffer, std::error_code& ec) noexcept
+    template <typename Buffer>
+    ssize_t sendBuffer(Buffer& buffer, std::error_code& ec) noexcept
     {
         return derived().sendBufferImpl(buffer, ec);
     }
@@ -145,6 +145,15 @@ public:
         return true;
     }
 
+    /// @brief Takes ownership of a connected descriptor, e.g. one accepted by another thread.
+    static UnixSocket adopt(SocketType fd, bool nonblock) noexcept
+    {
+        UnixSocket socket;
+        socket.fd_ = fd;
+        socket.isNonBlocking_ = nonblock;
+        return socket;
+    }
+
     UnixSocket accept(std::error_code& ec)
     {
         if (!isValidImpl())
@@ -153,23 +162,14 @@ public:
             return UnixSocket();
         }
 
-        SocketType clientFd = Accept(fd_, nullptr, nullptr, ec);
+        SocketType clientFd = Accept4(fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC, ec);
         if (clientFd < 0)
         {
             return UnixSocket();
         }
 
-        SetNonBlocking(clientFd, true, ec);
-        if (ec)
-        {
-            return UnixSocket();
-        }
-
-        UnixSocket client;
-        client.fd_ = clientFd;
-        client.isNonBlocking_ = true;
-
-        return client;
+        ec.clear();
+        return adopt(clientFd, true);
     }
 
 private:
@@ -227,7 +227,8 @@ private:
         return n;
     }
 
-    ssize_t recvBufferImpl(ByteBuffer& buffer, std::error_code& ec) noexcept
+    template <typename Buffer>
+    ssize_t recvBufferImpl(Buffer& buffer, std::error_code& ec) noexcept
     {
         size_t available;
         uint8_t* ptr = buffer.prepareWrite(available);
@@ -248,7 +249,8 @@ private:
         return len;
     }
 
-    ssize_t sendBufferImpl(ByteBuffer& buffer, std::error_code& ec) noexcept
+    template <typename Buffer>
+    ssize_t sendBufferImpl(Buffer& buffer, std::error_code& ec) noexcept
     {
         size_t available;
         const uint8_t* ptr = buffer.prepareRead(available);
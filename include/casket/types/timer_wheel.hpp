@@ -0,0 +1,455 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace casket
+{
+
+/// @brief Handle of a timer owned by a TimerWheel.
+struct TimerHandle
+{
+    uint32_t index{UINT32_MAX};
+    uint32_t generation{0};
+
+    bool isValid() const noexcept
+    {
+        return index != UINT32_MAX;
+    }
+};
+
+/// @brief Hierarchical timing wheel with O(1) schedule and cancel.
+/// @details Four levels of 64 slots cover 64^4 ticks; longer delays are parked in the last level and
+///          cascaded again. Timers never fire early, they fire on the first advance() at or after the
+///          tick of their expiry.
+/// @note Not thread-safe, the wheel is meant to be driven by a single event loop or by TimerService.
+class TimerWheel final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+private:
+    struct Link
+    {
+        Link* prev{this};
+        Link* next{this};
+
+        Link() = default;
+        Link(const Link&) = delete;
+        Link& operator=(const Link&) = delete;
+
+        bool linked() const noexcept
+        {
+            return next != this;
+        }
+
+        void unlink() noexcept
+        {
+            prev->next = next;
+            next->prev = prev;
+            prev = next = this;
+        }
+
+        void pushBack(Link* node) noexcept
+        {
+            node->prev = prev;
+            node->next = this;
+            prev->next = node;
+            prev = node;
+        }
+    };
+
+    static constexpr size_t kLevelBits = 6;
+    static constexpr size_t kSlots = size_t(1) << kLevelBits;
+    static constexpr size_t kLevels = 4;
+    static constexpr uint8_t kDetached = UINT8_MAX;
+
+public:
+    /// @brief Timer node embedded in user objects.
+    /// @details A scheduled timer must outlive its registration or be cancelled before destruction.
+    class Timer : private Link
+    {
+    public:
+        Timer() = default;
+
+        explicit Timer(Callback callback)
+            : callback_(std::move(callback))
+        {
+        }
+
+        ~Timer() noexcept
+        {
+            if (wheel_)
+            {
+                wheel_->cancel(*this);
+            }
+        }
+
+        void setCallback(Callback callback)
+        {
+            callback_ = std::move(callback);
+        }
+
+        bool isScheduled() const noexcept
+        {
+            return wheel_ != nullptr;
+        }
+
+    private:
+        friend class TimerWheel;
+
+        Callback callback_;
+        TimerWheel* wheel_{nullptr};
+        uint64_t expiry_{0};
+        uint8_t level_{kDetached};
+        uint8_t slot_{0};
+        uint32_t generation_{0};
+        uint32_t index_{UINT32_MAX}; ///< Slot in the owned timer pool, UINT32_MAX for intrusive timers.
+    };
+
+    /// @brief Constructs a wheel.
+    /// @param[in] resolution duration of one tick.
+    /// @param[in] now time point of tick zero.
+    explicit TimerWheel(Clock::duration resolution = std::chrono::milliseconds(1), Clock::time_point now = Clock::now())
+        : resolution_(resolution.count() > 0 ? resolution : Clock::duration(1))
+        , start_(now)
+    {
+    }
+
+    ~TimerWheel() noexcept
+    {
+        clear();
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /// @brief Schedules or reschedules an intrusive timer.
+    void schedule(Timer& timer, Clock::duration delay, Clock::time_point now = Clock::now())
+    {
+        scheduleAt(timer, now + delay);
+    }
+
+    void scheduleAt(Timer& timer, Clock::time_point when)
+    {
+        if (timer.wheel_)
+        {
+            timer.wheel_->cancel(timer);
+        }
+
+        // Round up so that a timer never fires before its deadline.
+        auto elapsed = when - start_ + resolution_ - Clock::duration(1);
+        uint64_t expiry = elapsed.count() <= 0 ? 0 : static_cast<uint64_t>(elapsed / resolution_);
+
+        timer.wheel_ = this;
+        timer.expiry_ = expiry > now_ ? expiry : now_ + 1;
+        ++size_;
+        insert(timer);
+    }
+
+    /// @brief Schedules a callback owned by the wheel.
+    /// @return handle that can be passed to cancel() until the timer fires.
+    TimerHandle scheduleAfter(Clock::duration delay, Callback callback, Clock::time_point now = Clock::now())
+    {
+        uint32_t index;
+        if (!freeTimers_.empty())
+        {
+            index = freeTimers_.back();
+            freeTimers_.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(ownedTimers_.size());
+            ownedTimers_.emplace_back();
+        }
+
+        Timer& timer = ownedTimers_[index];
+        timer.index_ = index;
+        timer.callback_ = std::move(callback);
+        schedule(timer, delay, now);
+
+        return TimerHandle{index, timer.generation_};
+    }
+
+    /// @brief Cancels an intrusive timer, does nothing if it is not scheduled.
+    void cancel(Timer& timer) noexcept
+    {
+        if (timer.wheel_ != this)
+        {
+            return;
+        }
+
+        detach(timer);
+        if (timer.index_ != UINT32_MAX)
+        {
+            release(timer);
+        }
+    }
+
+    /// @brief Cancels an owned timer.
+    /// @return false if the timer already fired or was cancelled.
+    bool cancel(TimerHandle handle) noexcept
+    {
+        if (handle.index >= ownedTimers_.size())
+        {
+            return false;
+        }
+
+        Timer& timer = ownedTimers_[handle.index];
+        if (timer.generation_ != handle.generation || timer.wheel_ != this)
+        {
+            return false;
+        }
+
+        cancel(timer);
+        return true;
+    }
+
+    /// @brief Fires every timer that expired up to the given time.
+    /// @return number of fired timers.
+    size_t advance(Clock::time_point now = Clock::now())
+    {
+        uint64_t target = toTick(now);
+        size_t fired = 0;
+
+        while (now_ < target)
+        {
+            if (size_ == 0)
+            {
+                now_ = target;
+                break;
+            }
+
+            ++now_;
+            for (size_t level = 1; level < kLevels; ++level)
+            {
+                if ((now_ & mask(level)) != 0)
+                {
+                    break;
+                }
+                cascade(level, static_cast<size_t>(now_ >> (kLevelBits * level)) & (kSlots - 1));
+            }
+
+            fired += expire(static_cast<size_t>(now_ & (kSlots - 1)));
+        }
+
+        return fired;
+    }
+
+    /// @brief Returns the time until the wheel needs to be advanced again.
+    /// @return duration until the next expiry or cascade, Clock::duration::max() if no timer is scheduled.
+    Clock::duration nextTimeout(Clock::time_point now = Clock::now()) const noexcept
+    {
+        if (size_ == 0)
+        {
+            return Clock::duration::max();
+        }
+
+        uint64_t next = UINT64_MAX;
+        for (size_t level = 0; level < kLevels; ++level)
+        {
+            uint64_t occupied = occupied_[level];
+            if (occupied == 0)
+            {
+                continue;
+            }
+
+            uint64_t base = (now_ >> (kLevelBits * level)) + 1;
+            auto first = static_cast<size_t>(base & (kSlots - 1));
+            uint64_t rotated = (occupied >> first) | (first ? occupied << (kSlots - first) : 0);
+            uint64_t distance = static_cast<uint64_t>(__builtin_ctzll(rotated));
+            uint64_t tick = (base + distance) << (kLevelBits * level);
+
+            if (tick < next)
+            {
+                next = tick;
+            }
+        }
+
+        auto deadline = start_ + resolution_ * static_cast<Clock::rep>(next);
+        return deadline > now ? deadline - now : Clock::duration::zero();
+    }
+
+    /// @brief Returns nextTimeout() in milliseconds rounded up and clamped to maxMs, suitable for poll timeouts.
+    int nextTimeoutMs(int maxMs, Clock::time_point now = Clock::now()) const noexcept
+    {
+        auto timeout = nextTimeout(now);
+        if (timeout == Clock::duration::max())
+        {
+            return maxMs;
+        }
+
+        auto ms = std::chrono::ceil<std::chrono::milliseconds>(timeout).count();
+        if (maxMs >= 0 && ms > maxMs)
+        {
+            return maxMs;
+        }
+        // An unbounded wait must not wrap to a negative value, poll would treat that as infinite.
+        return static_cast<int>(std::min<decltype(ms)>(ms, std::numeric_limits<int>::max()));
+    }
+
+    /// @brief Cancels every scheduled timer.
+    void clear() noexcept
+    {
+        for (size_t level = 0; level < kLevels; ++level)
+        {
+            for (auto& slot : wheel_[level])
+            {
+                while (slot.linked())
+                {
+                    cancel(*static_cast<Timer*>(slot.next));
+                }
+            }
+        }
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    Clock::duration resolution() const noexcept
+    {
+        return resolution_;
+    }
+
+private:
+    static constexpr uint64_t mask(size_t level) noexcept
+    {
+        return (uint64_t(1) << (kLevelBits * level)) - 1;
+    }
+
+    uint64_t toTick(Clock::time_point now) const noexcept
+    {
+        auto elapsed = now - start_;
+        return elapsed.count() <= 0 ? 0 : static_cast<uint64_t>(elapsed / resolution_);
+    }
+
+    void insert(Timer& timer) noexcept
+    {
+        uint64_t delta = timer.expiry_ - now_;
+        uint64_t expiry = timer.expiry_;
+
+        size_t level = 0;
+        while (level + 1 < kLevels && delta >= (uint64_t(1) << (kLevelBits * (level + 1))))
+        {
+            ++level;
+        }
+
+        if (level + 1 == kLevels && delta >= (uint64_t(1) << (kLevelBits * kLevels)))
+        {
+            // Parked until the last level slot is cascaded, then reinserted with the real expiry.
+            expiry = now_ + (uint64_t(1) << (kLevelBits * kLevels)) - 1;
+        }
+
+        auto slot = static_cast<size_t>(expiry >> (kLevelBits * level)) & (kSlots - 1);
+        timer.level_ = static_cast<uint8_t>(level);
+        timer.slot_ = static_cast<uint8_t>(slot);
+        wheel_[level][slot].pushBack(&timer);
+        occupied_[level] |= uint64_t(1) << slot;
+    }
+
+    void detach(Timer& timer) noexcept
+    {
+        timer.unlink();
+        if (timer.level_ != kDetached && !wheel_[timer.level_][timer.slot_].linked())
+        {
+            occupied_[timer.level_] &= ~(uint64_t(1) << timer.slot_);
+        }
+        timer.level_ = kDetached;
+        timer.wheel_ = nullptr;
+        --size_;
+    }
+
+    void release(Timer& timer) noexcept
+    {
+        timer.callback_ = nullptr;
+        ++timer.generation_;
+        freeTimers_.push_back(timer.index_);
+    }
+
+    void takeSlot(size_t level, size_t slot, Link& pending) noexcept
+    {
+        Link& head = wheel_[level][slot];
+        if (!head.linked())
+        {
+            return;
+        }
+
+        pending.next = head.next;
+        pending.prev = head.prev;
+        pending.next->prev = &pending;
+        pending.prev->next = &pending;
+        head.prev = head.next = &head;
+        occupied_[level] &= ~(uint64_t(1) << slot);
+
+        for (Link* node = pending.next; node != &pending; node = node->next)
+        {
+            static_cast<Timer*>(node)->level_ = kDetached;
+        }
+    }
+
+    void cascade(size_t level, size_t slot) noexcept
+    {
+        Link pending;
+        takeSlot(level, slot, pending);
+
+        while (pending.linked())
+        {
+            auto* timer = static_cast<Timer*>(pending.next);
+            timer->unlink();
+            insert(*timer);
+        }
+    }
+
+    size_t expire(size_t slot)
+    {
+        Link pending;
+        takeSlot(0, slot, pending);
+
+        size_t fired = 0;
+        while (pending.linked())
+        {
+            auto* timer = static_cast<Timer*>(pending.next);
+            detach(*timer);
+
+            // The callback may destroy or reschedule its timer, so it runs from a local copy.
+            bool owned = timer->index_ != UINT32_MAX;
+            Callback callback = owned ? std::move(timer->callback_) : timer->callback_;
+            if (owned)
+            {
+                release(*timer);
+            }
+
+            ++fired;
+            if (callback)
+            {
+                callback();
+            }
+        }
+        return fired;
+    }
+
+private:
+    std::array<std::array<Link, kSlots>, kLevels> wheel_;
+    std::array<uint64_t, kLevels> occupied_{};
+    std::deque<Timer> ownedTimers_;
+    std::vector<uint32_t> freeTimers_;
+    Clock::duration resolution_;
+    Clock::time_point start_;
+    uint64_t now_{0};
+    size_t size_{0};
+};
+
+} // namespace casket
@@ -1,5 +1,6 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
 #include <vector>
 #include <casket/types/flat_hash_table.hpp>
 
@@ -316,6 +317,32 @@ public:
         size_--;
     }
 
+    /// @brief Removes expired entries starting from the least recently used one.
+    /// @details Meant to be called periodically, e.g. from a TimerWheel timer, so that entries which are
+    ///          never looked up again do not hold their slots until LRU eviction.
+    /// @param[in] now time point to expiry.
+    /// @param[in] maxScan maximum number of entries inspected by one call.
+    /// @return number of removed entries.
+    size_t purgeExpired(const std::chrono::steady_clock::time_point& now = std::chrono::steady_clock::now(),
+                        size_t maxScan = SIZE_MAX)
+    {
+        size_t removed = 0;
+        int index = tail_;
+
+        for (size_t scanned = 0; index != -1 && scanned < maxScan; ++scanned)
+        {
+            int prev = pool_[index].prev;
+            if (pool_[index].expiry <= now)
+            {
+                erase(pool_[index].key);
+                ++removed;
+            }
+            index = prev;
+        }
+
+        return removed;
+    }
+
     /// @brief Resizes the cache, clearing all existing data.
     /// @param[in] newMaxSize new maximum capacity.
     /// @throws std::invalid_argument if newMaxSize is zero.
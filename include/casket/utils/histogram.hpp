@@ -0,0 +1,145 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+
+namespace casket
+{
+
+/// @brief Lock-free histogram with power-of-two buckets.
+/// @details Bucket 0 counts zero samples, bucket i counts samples in [2^(i-1), 2^i).
+///          Recording is wait-free and safe from any number of threads.
+class Log2Histogram final
+{
+public:
+    static constexpr size_t kBucketCount = 65;
+
+    Log2Histogram() noexcept
+    {
+        reset();
+    }
+
+    Log2Histogram(const Log2Histogram&) = delete;
+    Log2Histogram& operator=(const Log2Histogram&) = delete;
+
+    /// @brief Adds a sample to the histogram.
+    /// @param[in] value sample value.
+    void record(uint64_t value) noexcept
+    {
+        buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t currentMax = max_.load(std::memory_order_relaxed);
+        while (value > currentMax &&
+               !max_.compare_exchange_weak(currentMax, value, std::memory_order_relaxed, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /// @brief Clears all samples.
+    void reset() noexcept
+    {
+        for (auto& bucket : buckets_)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const noexcept
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t sum() const noexcept
+    {
+        return sum_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t max() const noexcept
+    {
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    double mean() const noexcept
+    {
+        uint64_t samples = count();
+        return samples > 0 ? static_cast<double>(sum()) / samples : 0.0;
+    }
+
+    uint64_t bucket(size_t index) const noexcept
+    {
+        return index < kBucketCount ? buckets_[index].load(std::memory_order_relaxed) : 0;
+    }
+
+    /// @brief Returns the exclusive upper bound of the bucket.
+    static uint64_t bucketUpperBound(size_t index) noexcept
+    {
+        if (index == 0)
+        {
+            return 1;
+        }
+        if (index >= 64)
+        {
+            return UINT64_MAX;
+        }
+        return uint64_t(1) << index;
+    }
+
+    static size_t bucketIndex(uint64_t value) noexcept
+    {
+        return value == 0 ? 0 : static_cast<size_t>(64 - __builtin_clzll(value));
+    }
+
+    /// @brief Estimates a percentile as the upper bound of the bucket containing it.
+    /// @param[in] fraction requested percentile in range [0, 1].
+    /// @return bucket upper bound clamped to the maximum observed value.
+    uint64_t percentile(double fraction) const noexcept
+    {
+        uint64_t samples = count();
+        if (samples == 0)
+        {
+            return 0;
+        }
+
+        uint64_t threshold = static_cast<uint64_t>(fraction * static_cast<double>(samples));
+        if (threshold == 0)
+        {
+            threshold = 1;
+        }
+
+        uint64_t accumulated = 0;
+        for (size_t i = 0; i < kBucketCount; ++i)
+        {
+            accumulated += bucket(i);
+            if (accumulated >= threshold)
+            {
+                uint64_t bound = bucketUpperBound(i);
+                uint64_t observedMax = max();
+                return bound > observedMax ? observedMax : bound;
+            }
+        }
+        return max();
+    }
+
+    void print(std::ostream& os, const char* unit) const
+    {
+        os << "count=" << count() << " mean=" << std::fixed << std::setprecision(2) << mean() << unit
+           << " p50=" << percentile(0.50) << unit << " p99=" << percentile(0.99) << unit << " max=" << max() << unit
+           << "\n";
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+} // namespace casket
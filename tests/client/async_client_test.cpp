@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <casket/client/async_client.hpp>
+#include <casket/client/generic_client.hpp>
+#include <casket/server/generic_server.hpp>
+
+#include "common/server_test_utils.hpp"
+
+using namespace casket;
+using namespace casket::test;
+
+namespace
+{
+
+const char* kPath = "/tmp/casket_async_client_test.sock";
+
+using Reply = Correlated<TextMessage>;
+
+// Echoes every request of a batch back in reverse order, so responses never arrive in request order.
+void EchoReversed(Context<UnixSocket>& ctx)
+{
+    std::error_code ec;
+    std::vector<std::pair<uint64_t, std::string>> batch;
+    ctx.readThenUnpackAll<Reply>(
+        [&](const Reply& request)
+        { batch.emplace_back(request.id, std::string(request.message.text.data(), request.message.text.size())); },
+        ec);
+
+    for (auto it = batch.rbegin(); it != batch.rend(); ++it)
+    {
+        ctx.packThenSend(Reply{it->first, TextMessage{it->second}}, ec);
+    }
+}
+
+template <typename Server, typename Condition>
+void RunUntil(Server& server, AsyncClient<UnixSocket>& client, Condition done)
+{
+    std::error_code ec;
+    for (int i = 0; i < 1000 && !done(); ++i)
+    {
+        server.step();
+        client.poll(0, ec);
+    }
+}
+
+} // namespace
+
+TEST(AsyncClientTest, MatchesOutOfOrderResponsesById)
+{
+    GenericServer<UnixSocket> server(FastConfig());
+    server.setConnectionHandler(EchoReversed);
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(kPath, -1, 16, ec)) << ec.message();
+    server.start();
+
+    AsyncClient<UnixSocket> client;
+    ASSERT_TRUE(client.connect(kPath, -1, ec)) << ec.message();
+
+    std::vector<std::string> responses(32);
+    for (size_t i = 0; i < responses.size(); ++i)
+    {
+        std::string text = "request-" + std::to_string(i);
+        ASSERT_TRUE(client.request<TextMessage>(
+            TextMessage{text},
+            [&responses, i](const std::error_code& error, const TextMessage* response)
+            {
+                ASSERT_FALSE(error) << error.message();
+                responses[i].assign(response->text.data(), response->text.size());
+            },
+            ec))
+            << ec.message();
+    }
+    EXPECT_EQ(client.inFlight(), responses.size());
+
+    RunUntil(server, client, [&] { return client.inFlight() == 0; });
+    EXPECT_TRUE(client.isConnected());
+    for (size_t i = 0; i < responses.size(); ++i)
+    {
+        EXPECT_EQ(responses[i], "request-" + std::to_string(i));
+    }
+    server.stop();
+}
+
+TEST(AsyncClientTest, GrowsBuffersThatStartEmpty)
+{
+    GenericServer<UnixSocket> server(FastConfig());
+    server.setConnectionHandler(EchoReversed);
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(kPath, -1, 16, ec)) << ec.message();
+    server.start();
+
+    AsyncClientConfig config;
+    config.bufferSize = 0;
+    AsyncClient<UnixSocket> client(config);
+    ASSERT_TRUE(client.connect(kPath, -1, ec)) << ec.message();
+
+    std::string text(10000, 'e');
+    std::string response;
+    ASSERT_TRUE(client.request<TextMessage>(
+        TextMessage{text},
+        [&response](const std::error_code& error, const TextMessage* reply)
+        {
+            ASSERT_FALSE(error) << error.message();
+            response.assign(reply->text.data(), reply->text.size());
+        },
+        ec))
+        << ec.message();
+
+    RunUntil(server, client, [&] { return client.inFlight() == 0; });
+    EXPECT_EQ(response, text);
+    server.stop();
+}
+
+TEST(AsyncClientTest, BoundsRequestsInFlight)
+{
+    GenericServer<UnixSocket> server(FastConfig());
+    server.setConnectionHandler(EchoReversed);
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(kPath, -1, 16, ec)) << ec.message();
+    server.start();
+
+    AsyncClientConfig config;
+    config.maxInFlight = 4;
+    AsyncClient<UnixSocket> client(config);
+    ASSERT_TRUE(client.connect(kPath, -1, ec)) << ec.message();
+
+    size_t completed = 0;
+    auto onReply = [&](const std::error_code& error, const TextMessage*) { completed += !error; };
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(client.request<TextMessage>(TextMessage{"x"}, onReply, ec));
+    }
+    EXPECT_FALSE(client.request<TextMessage>(TextMessage{"x"}, onReply, ec));
+    EXPECT_EQ(ec, std::errc::resource_unavailable_try_again);
+
+    RunUntil(server, client, [&] { return completed == 4; });
+    ec.clear();
+    EXPECT_TRUE(client.request<TextMessage>(TextMessage{"x"}, onReply, ec)) << ec.message();
+    RunUntil(server, client, [&] { return completed == 5; });
+    EXPECT_EQ(completed, 5u);
+    server.stop();
+}
+
+TEST(AsyncClientTest, FailsPendingRequestsWhenServerCloses)
+{
+    GenericServer<UnixSocket> server(FastConfig());
+    server.setConnectionHandler(
+        [](Context<UnixSocket>& ctx)
+        {
+            std::error_code ec;
+            ctx.readThenUnpackAll<Reply>([](const Reply&) {}, ec);
+            ctx.requestClose();
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(kPath, -1, 16, ec)) << ec.message();
+    server.start();
+
+    AsyncClient<UnixSocket> client;
+    ASSERT_TRUE(client.connect(kPath, -1, ec)) << ec.message();
+
+    std::vector<std::error_code> errors;
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(client.request<TextMessage>(
+            TextMessage{"never answered"},
+            [&](const std::error_code& error, const TextMessage* response)
+            {
+                EXPECT_EQ(response, nullptr);
+                errors.push_back(error);
+            },
+            ec));
+    }
+
+    RunUntil(server, client, [&] { return !client.isValid(); });
+    ASSERT_EQ(errors.size(), 3u);
+    for (const auto& error : errors)
+    {
+        EXPECT_TRUE(error);
+    }
+    EXPECT_FALSE(client.request<TextMessage>(TextMessage{"late"}, nullptr, ec));
+    EXPECT_EQ(ec, std::errc::not_connected);
+    server.stop();
+}
+
+TEST(AsyncClientTest, ReportsRefusedConnect)
+{
+    AsyncClient<UnixSocket> client;
+    std::error_code ec;
+    EXPECT_FALSE(client.connect("/tmp/casket_async_client_missing.sock", -1, ec));
+    EXPECT_TRUE(ec);
+    EXPECT_FALSE(client.isValid());
+}
+
+TEST(AsyncClientBenchmark, PipelinedAgainstSequentialRoundTrips)
+{
+    constexpr int kRequests = 20000;
+
+    GenericServerConfig config = FastConfig();
+    GenericServer<UnixSocket> server(config);
+    server.setConnectionHandler(EchoReversed);
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(kPath, -1, 16, ec)) << ec.message();
+    server.start();
+
+    using Clock = std::chrono::steady_clock;
+    std::string text(64, 'p');
+
+    GenericClient<UnixSocket> sequential;
+    ASSERT_TRUE(sequential.connect(kPath, -1, false, ec)) << ec.message();
+    while (server.getClientCount() == 0)
+    {
+        server.step();
+    }
+    auto start = Clock::now();
+    for (int i = 0; i < kRequests; ++i)
+    {
+        ASSERT_TRUE(sequential.send(Reply{static_cast<uint64_t>(i), TextMessage{text}}, ec));
+        server.step();
+        ASSERT_TRUE(sequential.receive<Reply>(ec)) << ec.message();
+    }
+    auto sequentialTime = Clock::now() - start;
+
+    AsyncClient<UnixSocket> pipelined;
+    ASSERT_TRUE(pipelined.connect(kPath, -1, ec)) << ec.message();
+    int sent = 0;
+    int completed = 0;
+    auto onReply = [&](const std::error_code& error, const TextMessage*) { completed += !error; };
+    start = Clock::now();
+    while (completed < kRequests)
+    {
+        while (sent < kRequests && pipelined.request<TextMessage>(TextMessage{text}, onReply, ec))
+        {
+            ++sent;
+        }
+        ec.clear();
+        server.step();
+        pipelined.poll(0, ec);
+        ASSERT_FALSE(ec) << ec.message();
+    }
+    auto pipelinedTime = Clock::now() - start;
+
+    using Ms = std::chrono::duration<double, std::milli>;
+    std::printf("[ Async    ] %d requests: sequential %.2f ms, pipelined %.2f ms\n", kRequests,
+                Ms(sequentialTime).count(), Ms(pipelinedTime).count());
+    server.stop();
+}
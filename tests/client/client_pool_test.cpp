@@ -0,0 +1,278 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <casket/client/client_pool.hpp>
+#include <casket/server/generic_server.hpp>
+
+#include "common/server_test_utils.hpp"
+
+using namespace casket;
+using namespace casket::test;
+
+namespace
+{
+
+const char* kPath = "/tmp/casket_client_pool_test.sock";
+
+void Echo(Context<UnixSocket>& ctx)
+{
+    std::error_code ec;
+    ctx.readThenUnpackAll<TextMessage>([&](const TextMessage& message) { ctx.packThenSend(message, ec); }, ec);
+}
+
+void StartEchoServer(GenericServer<UnixSocket>& server)
+{
+    std::error_code ec;
+    server.setConnectionHandler(Echo);
+    ASSERT_TRUE(server.listen(kPath, -1, 16, ec)) << ec.message();
+    server.start();
+}
+
+void RoundTrip(GenericServer<UnixSocket>& server, ClientPool<UnixSocket>::Client& client, const std::string& text)
+{
+    std::error_code ec;
+    auto sent = server.getStatistics().totalBytesSent.load();
+    ASSERT_TRUE(client.send(TextMessage{text}, ec)) << ec.message();
+    for (int i = 0; i < 100 && server.getStatistics().totalBytesSent.load() == sent; ++i)
+    {
+        server.step();
+    }
+
+    auto reply = client.receive<TextMessage>(ec);
+    ASSERT_TRUE(reply) << ec.message();
+    EXPECT_EQ(std::string(reply->text.data(), reply->text.size()), text);
+}
+
+} // namespace
+
+TEST(ClientPoolTest, ReusesWarmConnections)
+{
+    GenericServer<UnixSocket> server(FastConfig());
+    StartEchoServer(server);
+
+    ClientPoolConfig config;
+    config.connections = 2;
+    ClientPool<UnixSocket> pool(kPath, -1, config);
+
+    std::error_code ec;
+    ASSERT_TRUE(pool.warmUp(ec)) << ec.message();
+    EXPECT_EQ(pool.connects(), 2u);
+
+    int fd = -1;
+    {
+        auto lease = pool.checkout(ec);
+        ASSERT_TRUE(lease) << ec.message();
+        fd = lease->getFd();
+        RoundTrip(server, *lease, "first");
+        EXPECT_EQ(pool.leased(), 1u);
+    }
+    EXPECT_EQ(pool.leased(), 0u);
+
+    auto lease = pool.checkout(ec);
+    ASSERT_TRUE(lease) << ec.message();
+    EXPECT_EQ(lease->getFd(), fd);
+    RoundTrip(server, *lease, "second");
+    EXPECT_EQ(pool.connects(), 2u);
+
+    lease.release();
+    server.stop();
+}
+
+TEST(ClientPoolTest, CheckoutFailsWhenAllConnectionsAreLeased)
+{
+    GenericServer<UnixSocket> server(FastConfig());
+    StartEchoServer(server);
+
+    ClientPoolConfig config;
+    config.connections = 2;
+    ClientPool<UnixSocket> pool(kPath, -1, config);
+
+    std::error_code ec;
+    auto first = pool.checkout(ec);
+    auto second = pool.checkout(ec);
+    ASSERT_TRUE(first && second) << ec.message();
+    EXPECT_NE(first->getFd(), second->getFd());
+
+    auto third = pool.checkout(ec);
+    EXPECT_FALSE(third);
+    EXPECT_EQ(ec, std::errc::resource_unavailable_try_again);
+
+    second.release();
+    third = pool.checkout(ec);
+    EXPECT_TRUE(third) << ec.message();
+
+    first.release();
+    third.release();
+    server.stop();
+}
+
+TEST(ClientPoolTest, ReplacesConnectionsClosedByPeer)
+{
+    ClientPoolConfig config;
+    config.connections = 1;
+    config.healthCheckInterval = std::chrono::milliseconds(0);
+    ClientPool<UnixSocket> pool(kPath, -1, config);
+
+    std::error_code ec;
+    {
+        GenericServer<UnixSocket> server(FastConfig());
+        StartEchoServer(server);
+        ASSERT_TRUE(pool.warmUp(ec)) << ec.message();
+        auto lease = pool.checkout(ec);
+        ASSERT_TRUE(lease) << ec.message();
+        RoundTrip(server, *lease, "before");
+        lease.release();
+        server.stop();
+    }
+
+    GenericServer<UnixSocket> server(FastConfig());
+    StartEchoServer(server);
+
+    auto lease = pool.checkout(ec);
+    ASSERT_TRUE(lease) << ec.message();
+    EXPECT_EQ(pool.failedHealthChecks(), 1u);
+    EXPECT_EQ(pool.connects(), 2u);
+    RoundTrip(server, *lease, "after");
+
+    lease.release();
+    server.stop();
+}
+
+TEST(ClientPoolTest, BacksOffWhileEndpointIsDown)
+{
+    ::unlink(kPath);
+
+    ClientPoolConfig config;
+    config.connections = 1;
+    config.initialBackoff = std::chrono::milliseconds(100);
+    ClientPool<UnixSocket> pool(kPath, -1, config);
+
+    std::error_code ec;
+    EXPECT_FALSE(pool.warmUp(ec));
+    EXPECT_TRUE(ec);
+    EXPECT_EQ(pool.failedConnects(), 1u);
+
+    GenericServer<UnixSocket> server(FastConfig());
+    StartEchoServer(server);
+
+    // The endpoint is back but the connection waits for its backoff to expire.
+    EXPECT_FALSE(pool.checkout(ec));
+    EXPECT_TRUE(ec);
+    EXPECT_EQ(pool.failedConnects(), 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_EQ(pool.maintain(ec), 1u);
+    auto lease = pool.checkout(ec);
+    ASSERT_TRUE(lease) << ec.message();
+    RoundTrip(server, *lease, "recovered");
+
+    lease.release();
+    server.stop();
+}
+
+TEST(ClientPoolTest, ConcurrentCheckoutsNeverShareAConnection)
+{
+    UnixSocket listener;
+    std::error_code ec;
+    ASSERT_TRUE(listener.listen(kPath, 16, ec)) << ec.message();
+
+    ClientPoolConfig config;
+    config.connections = 4;
+    config.healthCheckInterval = std::chrono::hours(1);
+    ClientPool<UnixSocket> pool(kPath, -1, config);
+    ASSERT_TRUE(pool.warmUp(ec)) << ec.message();
+
+    std::atomic<int> owners[1024] = {};
+    std::atomic<size_t> checkouts{0};
+    std::atomic<bool> shared{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                for (int i = 0; i < 20000; ++i)
+                {
+                    std::error_code error;
+                    auto lease = pool.checkout(error);
+                    if (!lease)
+                    {
+                        continue;
+                    }
+                    auto& owner = owners[lease->getFd()];
+                    shared = shared || owner.fetch_add(1) != 0;
+                    owner.fetch_sub(1);
+                    ++checkouts;
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_FALSE(shared.load());
+    EXPECT_GT(checkouts.load(), 0u);
+    EXPECT_EQ(pool.leased(), 0u);
+    EXPECT_EQ(pool.connects(), 4u);
+}
+
+TEST(ClientPoolTest, MaintainDoesNotStarveCheckouts)
+{
+    UnixSocket listener;
+    std::error_code ec;
+    ASSERT_TRUE(listener.listen(kPath, 16, ec)) << ec.message();
+
+    ClientPoolConfig config;
+    config.connections = 4;
+    config.healthCheckInterval = std::chrono::milliseconds(0);
+    ClientPool<UnixSocket> pool(kPath, -1, config);
+    ASSERT_TRUE(pool.warmUp(ec)) << ec.message();
+
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> maintained{0};
+    std::thread maintainer(
+        [&]
+        {
+            while (!stop.load())
+            {
+                std::error_code error;
+                maintained += pool.maintain(error);
+            }
+        });
+
+    // Two borrowers never lease all four connections, so every checkout must succeed.
+    std::atomic<size_t> unavailable{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; ++t)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                for (int i = 0; i < 50000; ++i)
+                {
+                    std::error_code error;
+                    if (!pool.checkout(error))
+                    {
+                        ++unavailable;
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    stop = true;
+    maintainer.join();
+
+    EXPECT_EQ(unavailable.load(), 0u);
+    EXPECT_GT(maintained.load(), 0u);
+    EXPECT_EQ(pool.leased(), 0u);
+    EXPECT_EQ(pool.connects(), 4u);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <casket/pack/pack.hpp>
+#include <casket/server/generic_server.hpp>
+
+namespace casket::test
+{
+
+/// @brief Message carrying one packed string, shared by the server and client tests.
+struct TextMessage
+{
+    nonstd::string_view text;
+
+    PackResult<Packer*> pack(Packer& packer) const
+    {
+        return packer.pack(text);
+    }
+
+    static UnpackResult<TextMessage> unpack(Unpacker& unpacker)
+    {
+        auto result = unpacker.unpackString();
+        if (!result)
+        {
+            return UnpackResult<TextMessage>(result.error());
+        }
+        return TextMessage{result.value()};
+    }
+};
+
+/// @brief Server configuration for tests that step the loop by hand, wait() never blocks.
+inline GenericServerConfig FastConfig()
+{
+    GenericServerConfig config;
+    config.waitTimeoutMs = 0;
+    return config;
+}
+
+/// @brief Echoes raw bytes back without any framing.
+template <typename Transport>
+void EchoHandler(Context<Transport>& ctx)
+{
+    std::error_code ec;
+    ctx.transport.recvBuffer(ctx.readBuffer, ec);
+
+    size_t size = std::min(ctx.readBuffer.availableRead(), ctx.writeBuffer.availableWrite());
+    std::memcpy(ctx.writeBuffer.getWritePtr(), ctx.readBuffer.getReadPtr(), size);
+    ctx.writeBuffer.commitWrite(size);
+    ctx.readBuffer.commitRead(size);
+}
+
+/// @brief Sends message and reads until as many bytes came back or the connection ends.
+template <typename Transport>
+std::string Exchange(Transport& client, const std::string& message)
+{
+    std::error_code ec;
+    EXPECT_EQ(client.send(reinterpret_cast<const uint8_t*>(message.data()), message.size(), ec),
+              static_cast<ssize_t>(message.size()));
+
+    std::string reply;
+    uint8_t buffer[256];
+    while (reply.size() < message.size())
+    {
+        ssize_t n = client.recv(buffer, sizeof(buffer), ec);
+        if (n <= 0)
+        {
+            break;
+        }
+        reply.append(reinterpret_cast<const char*>(buffer), static_cast<size_t>(n));
+    }
+    return reply;
+}
+
+} // namespace casket::test
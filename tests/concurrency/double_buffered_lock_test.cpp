@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <casket/concurrency/double_buffered_lock.hpp>
+
+using namespace casket;
+
+TEST(DoubleBufferedLockTest, InitialValue)
+{
+    DoubleBufferedLock<std::string> lock("initial");
+
+    EXPECT_EQ(lock.load(), "initial");
+    EXPECT_EQ(lock.read([](const std::string& value) { return value.size(); }), 7u);
+}
+
+TEST(DoubleBufferedLockTest, StoreUpdatesBothInstances)
+{
+    DoubleBufferedLock<std::vector<int>> lock;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        lock.modify([i](std::vector<int>& value) { value.push_back(i); });
+        EXPECT_EQ(lock.load().size(), static_cast<size_t>(i + 1));
+    }
+
+    lock.store({7, 8});
+    EXPECT_EQ(lock.load(), (std::vector<int>{7, 8}));
+}
+
+TEST(DoubleBufferedLockTest, ReadersSeeCompleteValues)
+{
+    DoubleBufferedLock<std::vector<int>> lock(std::vector<int>(256, 0));
+    constexpr int NUM_READERS = 3;
+    std::atomic<bool> running{true};
+    std::atomic<bool> inconsistent{false};
+    std::atomic<int> reads{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < NUM_READERS; ++r)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                int last = 0;
+                while (running)
+                {
+                    lock.read(
+                        [&](const std::vector<int>& value)
+                        {
+                            for (int element : value)
+                            {
+                                if (element != value.front())
+                                {
+                                    inconsistent = true;
+                                }
+                            }
+                            if (value.front() < last)
+                            {
+                                inconsistent = true;
+                            }
+                            last = value.front();
+                        });
+                    reads++;
+                    std::this_thread::yield();
+                }
+            });
+    }
+
+    for (int i = 1; i <= 1000 || reads < NUM_READERS; ++i)
+    {
+        lock.store(std::vector<int>(256, i));
+        std::this_thread::yield();
+    }
+    running = false;
+
+    for (auto& th : readers)
+    {
+        th.join();
+    }
+
+    EXPECT_FALSE(inconsistent.load());
+}
+
+TEST(DoubleBufferedLockTest, ConcurrentWritersAreSerialized)
+{
+    DoubleBufferedLock<std::string> lock;
+    constexpr int NUM_WRITERS = 4;
+    constexpr int NUM_APPENDS = 200;
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < NUM_WRITERS; ++w)
+    {
+        writers.emplace_back(
+            [&]()
+            {
+                for (int i = 0; i < NUM_APPENDS; ++i)
+                {
+                    lock.modify([](std::string& value) { value.push_back('x'); });
+                }
+            });
+    }
+
+    for (auto& th : writers)
+    {
+        th.join();
+    }
+
+    EXPECT_EQ(lock.load().size(), static_cast<size_t>(NUM_WRITERS * NUM_APPENDS));
+}
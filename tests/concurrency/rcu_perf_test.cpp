@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <thread>
@@ -9,6 +10,7 @@
 using namespace casket;
 using namespace std::chrono;
 
+template <typename Domain>
 class RCUPerformanceTest : public ::testing::Test
 {
 protected:
@@ -35,15 +37,69 @@ protected:
 
         return results;
     }
+
+    /// Returns read-side critical sections per second with the given number of concurrent readers.
+    static double MeasureReadThroughput(int numReaders, milliseconds period)
+    {
+        Domain rcu;
+        std::atomic<bool> start{false};
+        std::atomic<bool> stop{false};
+        std::atomic<int> currentData{0};
+        std::vector<uint64_t> reads(numReaders * kPadding);
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < numReaders; ++i)
+        {
+            threads.emplace_back(
+                [&, i]()
+                {
+                    uint64_t local = 0;
+                    while (!start.load(std::memory_order_acquire))
+                    {
+                        std::this_thread::yield();
+                    }
+                    while (!stop.load(std::memory_order_relaxed))
+                    {
+                        auto epoch = rcu.readLock();
+                        volatile int value = currentData.load(std::memory_order_relaxed);
+                        (void)value;
+                        rcu.readUnlock(epoch);
+                        ++local;
+                    }
+                    reads[i * kPadding] = local;
+                });
+        }
+
+        start.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(period);
+        stop.store(true, std::memory_order_relaxed);
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        uint64_t total = 0;
+        for (int i = 0; i < numReaders; ++i)
+        {
+            total += reads[i * kPadding];
+        }
+        return static_cast<double>(total) / duration_cast<duration<double>>(period).count();
+    }
+
+    static constexpr int kPadding = 8; ///< Keeps per-thread results on separate cache lines.
 };
 
-TEST_F(RCUPerformanceTest, BasicPerformance)
+using RCUFlavors = ::testing::Types<RCU, DistributedRCU>;
+TYPED_TEST_SUITE(RCUPerformanceTest, RCUFlavors);
+
+TYPED_TEST(RCUPerformanceTest, BasicPerformance)
 {
     const int numReaders = 4;
     const int numWriters = 2;
     const int testDurationSec = 2;
 
-    RCU rcu;
+    TypeParam rcu;
     std::atomic<bool> stop{false};
     std::atomic<int> currentData{0};
 
@@ -134,7 +190,8 @@ TEST_F(RCUPerformanceTest, BasicPerformance)
         totalWriteTime += data.writeTime;
     }
 
-    auto results = CalculateResults(totalReads, totalWrites, totalReadTime, totalWriteTime, testDurationSec);
+    auto results =
+        TestFixture::CalculateResults(totalReads, totalWrites, totalReadTime, totalWriteTime, testDurationSec);
 
     EXPECT_GT(results.readOpsPerSec, 1000) << "Read operations per second should be reasonable";
     EXPECT_GT(results.writeOpsPerSec, 100) << "Write operations per second should be reasonable";
@@ -148,9 +205,9 @@ TEST_F(RCUPerformanceTest, BasicPerformance)
     std::cout << "Avg Write Latency: " << results.avgWriteLatencyNs << " ns\n";
 }
 
-TEST_F(RCUPerformanceTest, MultiThreadedConsistency)
+TYPED_TEST(RCUPerformanceTest, MultiThreadedConsistency)
 {
-    RCU rcu;
+    TypeParam rcu;
     std::atomic<int> data{0};
     std::atomic<bool> stop{false};
     std::atomic<int> consistencyErrors{0};
@@ -198,3 +255,29 @@ TEST_F(RCUPerformanceTest, MultiThreadedConsistency)
 
     EXPECT_EQ(consistencyErrors.load(), 0) << "No consistency errors should occur";
 }
+
+TYPED_TEST(RCUPerformanceTest, ReaderScaling)
+{
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32};
+    const int hardwareThreads = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+
+    std::cout << "RCU read throughput scaling:\n";
+    double single = 0;
+    for (int threads : threadCounts)
+    {
+        double opsPerSec = TestFixture::MeasureReadThroughput(threads, milliseconds(200));
+        if (threads == 1)
+        {
+            single = opsPerSec;
+        }
+
+        std::cout << "  " << threads << " readers: " << opsPerSec << " ops/s (x" << opsPerSec / single << ")\n";
+        EXPECT_GT(opsPerSec, 0);
+
+        // Only meaningful while every reader has a core of its own.
+        if (std::is_same_v<TypeParam, DistributedRCU> && threads > 1 && threads <= hardwareThreads / 2)
+        {
+            EXPECT_GT(opsPerSec, single) << "distributed readers should not slow each other down";
+        }
+    }
+}
@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <casket/concurrency/rcu_protected.hpp>
+
+using namespace casket;
+using namespace std::chrono;
+
+namespace
+{
+
+struct Config
+{
+    static std::atomic<int> instances;
+
+    int version{0};
+    int checksum{0};
+
+    Config() noexcept
+    {
+        ++instances;
+    }
+
+    Config(const Config& other) noexcept
+        : version(other.version)
+        , checksum(other.checksum)
+    {
+        ++instances;
+    }
+
+    ~Config()
+    {
+        --instances;
+    }
+};
+
+std::atomic<int> Config::instances{0};
+
+} // namespace
+
+TEST(RCUReclaimerTest, CallbackWaitsForActiveReaders)
+{
+    DistributedRCU rcu;
+    RCUReclaimer<DistributedRCU> reclaimer(rcu);
+    std::atomic<bool> called{false};
+
+    auto epoch = rcu.readLock();
+    reclaimer.callRCU([&called] { called = true; });
+
+    std::this_thread::sleep_for(milliseconds(50));
+    EXPECT_FALSE(called.load());
+
+    rcu.readUnlock(epoch);
+    reclaimer.barrier();
+    EXPECT_TRUE(called.load());
+}
+
+TEST(RCUReclaimerTest, CallbacksShareGracePeriods)
+{
+    DistributedRCU rcu;
+    RCUReclaimer<DistributedRCU> reclaimer(rcu);
+    const int count = 10000;
+
+    auto epoch = rcu.readLock();
+    for (int i = 0; i < count; ++i)
+    {
+        reclaimer.retire(new int(i));
+    }
+    rcu.readUnlock(epoch);
+    reclaimer.barrier();
+
+    EXPECT_EQ(reclaimer.completed(), static_cast<uint64_t>(count));
+    EXPECT_LT(reclaimer.gracePeriods(), static_cast<uint64_t>(count));
+}
+
+TEST(RCUReclaimerTest, DestructorRunsPendingCallbacks)
+{
+    DistributedRCU rcu;
+    std::atomic<int> called{0};
+    {
+        RCUReclaimer<DistributedRCU> reclaimer(rcu);
+        for (int i = 0; i < 100; ++i)
+        {
+            reclaimer.callRCU([&called] { ++called; });
+        }
+    }
+    EXPECT_EQ(called.load(), 100);
+}
+
+TEST(RCUProtectedTest, UpdateDoesNotWaitForReaders)
+{
+    DistributedRCU rcu;
+    RCUReclaimer<DistributedRCU> reclaimer(rcu);
+    RCUProtected<Config> config(reclaimer, std::make_unique<Config>());
+
+    {
+        auto guard = config.read();
+        auto start = steady_clock::now();
+        config.modify([](Config& value) { value.version = 1; });
+        EXPECT_LT(steady_clock::now() - start, milliseconds(100));
+
+        EXPECT_EQ(guard->version, 0);
+        EXPECT_EQ(config.read()->version, 1);
+    }
+
+    reclaimer.barrier();
+    EXPECT_EQ(Config::instances.load(), 1);
+}
+
+TEST(RCUProtectedTest, ConcurrentReadersAndWriters)
+{
+    DistributedRCU rcu;
+    std::atomic<bool> stop{false};
+    std::atomic<int> inconsistencies{0};
+    {
+        RCUReclaimer<DistributedRCU> reclaimer(rcu);
+        RCUProtected<Config> config(reclaimer, std::make_unique<Config>());
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back(
+                [&]()
+                {
+                    int lastVersion = 0;
+                    while (!stop.load(std::memory_order_relaxed))
+                    {
+                        auto guard = config.read();
+                        if (guard->checksum != guard->version * 7 || guard->version < lastVersion)
+                        {
+                            ++inconsistencies;
+                        }
+                        lastVersion = guard->version;
+                    }
+                });
+        }
+
+        std::vector<std::thread> writers;
+        for (int i = 0; i < 2; ++i)
+        {
+            writers.emplace_back(
+                [&]()
+                {
+                    for (int j = 0; j < 500; ++j)
+                    {
+                        config.modify(
+                            [](Config& value)
+                            {
+                                ++value.version;
+                                value.checksum = value.version * 7;
+                            });
+                    }
+                });
+        }
+
+        for (auto& writer : writers)
+        {
+            writer.join();
+        }
+        stop = true;
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        EXPECT_EQ(config.read()->version, 1000);
+    }
+
+    EXPECT_EQ(inconsistencies.load(), 0);
+    EXPECT_EQ(Config::instances.load(), 0);
+}
+
+TEST(RCUProtectedTest, ConcurrentUpdateAndModify)
+{
+    DistributedRCU rcu;
+    std::atomic<int> inconsistencies{0};
+    {
+        RCUReclaimer<DistributedRCU> reclaimer(rcu);
+        RCUProtected<Config> config(reclaimer, std::make_unique<Config>());
+        std::vector<std::thread> writers;
+
+        for (int i = 0; i < 2; ++i)
+        {
+            writers.emplace_back(
+                [&]()
+                {
+                    for (int j = 0; j < 2000; ++j)
+                    {
+                        auto value = std::make_unique<Config>();
+                        value->version = j;
+                        value->checksum = j * 7;
+                        config.update(std::move(value));
+                    }
+                });
+            writers.emplace_back(
+                [&]()
+                {
+                    for (int j = 0; j < 2000; ++j)
+                    {
+                        config.modify(
+                            [&inconsistencies](Config& value)
+                            {
+                                if (value.checksum != value.version * 7)
+                                {
+                                    ++inconsistencies;
+                                }
+                                ++value.version;
+                                value.checksum = value.version * 7;
+                            });
+                    }
+                });
+        }
+
+        for (auto& writer : writers)
+        {
+            writer.join();
+        }
+    }
+
+    EXPECT_EQ(inconsistencies.load(), 0);
+    EXPECT_EQ(Config::instances.load(), 0);
+}
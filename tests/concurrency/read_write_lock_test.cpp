@@ -5,7 +5,11 @@
 #include <vector>
 #include <array>
 #include <memory>
+#include <algorithm>
+#include <iostream>
 #include <casket/concurrency/read_write_lock.hpp>
+#include <casket/concurrency/sharded_read_write_lock.hpp>
+#include <casket/concurrency/fair_read_write_lock.hpp>
 
 using namespace casket;
 
@@ -662,3 +666,242 @@ TEST_F(ReadWriteLockTest, Compatibility_InterleavedReadWrite_ShouldWork)
 
     lock.readUnlock();
 }
+
+template <typename Lock>
+class ReadWriteLockVariantTest : public ::testing::Test
+{
+};
+
+using LockTypes = ::testing::Types<ReadWriteLock, ShardedReadWriteLock, FairReadWriteLock>;
+TYPED_TEST_SUITE(ReadWriteLockVariantTest, LockTypes);
+
+TYPED_TEST(ReadWriteLockVariantTest, TryLocks_ShouldRespectOwnership)
+{
+    TypeParam lock;
+
+    ASSERT_TRUE(lock.tryReadLock());
+    ASSERT_TRUE(lock.tryReadLock());
+    ASSERT_EQ(lock.readerCount(), 2u);
+    ASSERT_FALSE(lock.tryWriteLock());
+    lock.readUnlock();
+    lock.readUnlock();
+
+    ASSERT_TRUE(lock.tryWriteLock());
+    ASSERT_TRUE(lock.isLockedForWrite());
+    ASSERT_FALSE(lock.tryReadLock());
+    ASSERT_FALSE(lock.tryWriteLock());
+    lock.writeUnlock();
+
+    ASSERT_FALSE(lock.isLockedForRead());
+    ASSERT_FALSE(lock.isLockedForWrite());
+}
+
+TYPED_TEST(ReadWriteLockVariantTest, Guards_ShouldUnlock)
+{
+    TypeParam lock;
+
+    {
+        BasicReadLockGuard<TypeParam> guard(lock);
+        ASSERT_TRUE(lock.isLockedForRead());
+    }
+    ASSERT_FALSE(lock.isLockedForRead());
+
+    {
+        BasicWriteLockGuard<TypeParam> guard(lock);
+        ASSERT_TRUE(lock.isLockedForWrite());
+    }
+    ASSERT_FALSE(lock.isLockedForWrite());
+}
+
+TYPED_TEST(ReadWriteLockVariantTest, WriterWaitsForReader)
+{
+    TypeParam lock;
+    std::atomic<bool> writerDone{false};
+
+    lock.readLock();
+    std::thread writer(
+        [&]()
+        {
+            lock.writeLock();
+            writerDone = true;
+            lock.writeUnlock();
+        });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_FALSE(writerDone);
+
+    lock.readUnlock();
+    writer.join();
+    ASSERT_TRUE(writerDone);
+}
+
+TYPED_TEST(ReadWriteLockVariantTest, Concurrent_ReadersSeeConsistentPairs)
+{
+    TypeParam lock;
+    int first = 0;
+    int second = 0;
+    std::atomic<bool> stop{false};
+    std::atomic<int> inconsistencies{0};
+    std::atomic<int> totalReads{0};
+    const int numReaders = 4;
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < numReaders; ++r)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                while (!stop.load())
+                {
+                    lock.readLock();
+                    if (first != second)
+                    {
+                        inconsistencies++;
+                    }
+                    lock.readUnlock();
+                    totalReads++;
+                    std::this_thread::yield();
+                }
+            });
+    }
+
+    for (int i = 0; i < 2000 || totalReads.load() < numReaders; ++i)
+    {
+        lock.writeLock();
+        ++first;
+        ++second;
+        lock.writeUnlock();
+        std::this_thread::yield();
+    }
+    stop = true;
+
+    for (auto& t : readers)
+    {
+        t.join();
+    }
+
+    ASSERT_EQ(inconsistencies, 0);
+    ASSERT_EQ(first, second);
+}
+
+TEST(ReadWriteLockFairnessTest, WaitingWriterBlocksNewReaders)
+{
+    FairReadWriteLock lock;
+    std::atomic<bool> writerDone{false};
+    std::atomic<bool> readerDone{false};
+
+    lock.readLock();
+    std::thread writer(
+        [&]()
+        {
+            lock.writeLock();
+            writerDone = true;
+            lock.writeUnlock();
+        });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_FALSE(lock.tryReadLock());
+
+    std::thread reader(
+        [&]()
+        {
+            lock.readLock();
+            EXPECT_TRUE(writerDone.load());
+            readerDone = true;
+            lock.readUnlock();
+        });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_FALSE(readerDone);
+
+    lock.readUnlock();
+    writer.join();
+    reader.join();
+    ASSERT_TRUE(readerDone);
+}
+
+namespace
+{
+
+template <typename Lock>
+double MeasureMixedOps(int readPercent, int threads, std::chrono::milliseconds duration)
+{
+    Lock lock;
+    uint64_t shared = 0;
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> totalOps{0};
+    std::atomic<uint64_t> checksum{0};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back(
+            [&, t]()
+            {
+                uint32_t seed = 2654435761u * static_cast<uint32_t>(t + 1);
+                uint64_t ops = 0;
+                uint64_t sink = 0;
+                while (!start.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    seed = seed * 1664525u + 1013904223u;
+                    if (static_cast<int>((seed >> 16) % 100) < readPercent)
+                    {
+                        lock.readLock();
+                        sink += shared;
+                        lock.readUnlock();
+                    }
+                    else
+                    {
+                        lock.writeLock();
+                        ++shared;
+                        lock.writeUnlock();
+                    }
+                    ++ops;
+                }
+                totalOps.fetch_add(ops, std::memory_order_relaxed);
+                checksum.fetch_add(sink, std::memory_order_relaxed);
+            });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(duration);
+    stop.store(true);
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    return static_cast<double>(totalOps.load()) / elapsed;
+}
+
+} // namespace
+
+TEST(ReadWriteLockBenchmark, ReadMostlyMixes)
+{
+    const int threads = static_cast<int>(std::max(2u, std::min(8u, std::thread::hardware_concurrency())));
+    const auto duration = std::chrono::milliseconds(100);
+
+    for (int readPercent : {99, 90})
+    {
+        double base = MeasureMixedOps<ReadWriteLock>(readPercent, threads, duration);
+        double sharded = MeasureMixedOps<ShardedReadWriteLock>(readPercent, threads, duration);
+        double fair = MeasureMixedOps<FairReadWriteLock>(readPercent, threads, duration);
+
+        std::cout << "[" << readPercent << "/" << (100 - readPercent) << ", " << threads << " threads] "
+                  << "ReadWriteLock: " << static_cast<uint64_t>(base) << " ops/s, "
+                  << "ShardedReadWriteLock: " << static_cast<uint64_t>(sharded) << " ops/s, "
+                  << "FairReadWriteLock: " << static_cast<uint64_t>(fair) << " ops/s\n";
+
+        ASSERT_GT(base, 0.0);
+        ASSERT_GT(sharded, 0.0);
+        ASSERT_GT(fair, 0.0);
+    }
+}
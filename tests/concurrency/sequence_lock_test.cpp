@@ -5,6 +5,8 @@
 #include <random>
 #include <chrono>
 #include <mutex>
+#include <cstring>
+#include <algorithm>
 
 #include <casket/concurrency/sequence_lock.hpp>
 
@@ -87,15 +89,14 @@ TEST_F(SequenceLockTest, LargeObject)
 TEST_F(SequenceLockTest, SingleWriterSingleReader)
 {
     SequenceLock<int> lock;
-    std::atomic<bool> running{true};
     std::atomic<int> writer_count{0};
     std::atomic<int> reader_count{0};
 
-    // Writer thread
+    // Writer thread, runs to completion even if the reader is done first
     std::thread writer(
         [&]()
         {
-            for (int i = 0; i < 10000 && running; ++i)
+            for (int i = 0; i < 10000; ++i)
             {
                 lock.store(i);
                 writer_count++;
@@ -115,7 +116,6 @@ TEST_F(SequenceLockTest, SingleWriterSingleReader)
                 reader_count++;
             }
             (void)last_value;
-            running = false;
         });
 
     writer.join();
@@ -134,10 +134,18 @@ TEST_F(SequenceLockTest, SingleWriterMultipleReaders)
     constexpr int NUM_READERS = 4;
     constexpr int NUM_WRITES = 5000;
 
+    std::atomic<int> readers_started{0};
+
     // Writer thread
     std::thread writer(
         [&]()
         {
+            // Readers may not have been scheduled yet on a busy or single core machine
+            while (readers_started < NUM_READERS)
+            {
+                std::this_thread::yield();
+            }
+
             for (int i = 0; i < NUM_WRITES && running; ++i)
             {
                 lock.store(i);
@@ -157,6 +165,7 @@ TEST_F(SequenceLockTest, SingleWriterMultipleReaders)
             [&, r]()
             {
                 int last_value = -1;
+                readers_started++;
                 while (running)
                 {
                     int value = lock.load();
@@ -202,3 +211,127 @@ TEST_F(SequenceLockTest, RapidStoreLoad)
     }
 }
 
+TEST_F(SequenceLockTest, LargePayloadIsNeverTorn)
+{
+    struct Snapshot
+    {
+        uint64_t words[512];
+    };
+
+    SequenceLock<Snapshot> lock;
+    std::atomic<bool> running{true};
+    std::atomic<int> reads{0};
+    std::atomic<bool> torn{false};
+
+    std::thread reader(
+        [&]()
+        {
+            while (running)
+            {
+                Snapshot snapshot = lock.load();
+                for (uint64_t word : snapshot.words)
+                {
+                    if (word != snapshot.words[0])
+                    {
+                        torn = true;
+                    }
+                }
+                reads++;
+            }
+        });
+
+    Snapshot snapshot{};
+    for (uint64_t i = 1; i <= 2000 || reads < 10; ++i)
+    {
+        std::fill(std::begin(snapshot.words), std::end(snapshot.words), i);
+        lock.store(snapshot);
+        std::this_thread::yield();
+    }
+    running = false;
+    reader.join();
+
+    EXPECT_FALSE(torn.load());
+}
+
+TEST_F(SequenceLockTest, OddSizedPayload)
+{
+    struct Odd
+    {
+        char bytes[13];
+    };
+
+    SequenceLock<Odd> lock;
+    Odd value;
+    std::memset(value.bytes, 'z', sizeof(value.bytes));
+    lock.store(value);
+
+    Odd loaded = lock.load();
+    EXPECT_EQ(std::memcmp(loaded.bytes, value.bytes, sizeof(value.bytes)), 0);
+}
+
+TEST(MultiWriterSequenceLockTest, ConcurrentWritersKeepPayloadConsistent)
+{
+    struct Pair
+    {
+        uint64_t first;
+        uint64_t second;
+    };
+
+    MultiWriterSequenceLock<Pair> lock;
+    constexpr int NUM_WRITERS = 4;
+    constexpr int NUM_UPDATES = 2000;
+    std::atomic<bool> running{true};
+    std::atomic<bool> inconsistent{false};
+
+    std::thread reader(
+        [&]()
+        {
+            while (running)
+            {
+                Pair value = lock.load();
+                if (value.first != value.second)
+                {
+                    inconsistent = true;
+                }
+                std::this_thread::yield();
+            }
+        });
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < NUM_WRITERS; ++w)
+    {
+        writers.emplace_back(
+            [&]()
+            {
+                for (int i = 0; i < NUM_UPDATES; ++i)
+                {
+                    lock.update(
+                        [](Pair& value)
+                        {
+                            ++value.first;
+                            ++value.second;
+                        });
+                }
+            });
+    }
+
+    for (auto& th : writers)
+    {
+        th.join();
+    }
+    running = false;
+    reader.join();
+
+    Pair result = lock.load();
+    EXPECT_FALSE(inconsistent.load());
+    EXPECT_EQ(result.first, static_cast<uint64_t>(NUM_WRITERS * NUM_UPDATES));
+    EXPECT_EQ(result.second, result.first);
+}
+
+TEST(MultiWriterSequenceLockTest, StoreLoad)
+{
+    MultiWriterSequenceLock<double> lock;
+
+    lock.store(2.5);
+    EXPECT_DOUBLE_EQ(lock.load(), 2.5);
+}
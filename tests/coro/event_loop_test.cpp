@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <thread>
+#include <casket/coro/event_loop.hpp>
+#include <casket/thread/pool.hpp>
+
+using namespace casket;
+
+namespace
+{
+
+class EventLoopTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds_), 0);
+    }
+
+    void TearDown() override
+    {
+        ::close(fds_[0]);
+        ::close(fds_[1]);
+    }
+
+    int fds_[2]{-1, -1};
+    EventLoop loop_;
+};
+
+} // namespace
+
+TEST_F(EventLoopTest, ResumesOnReadable)
+{
+    std::error_code ec;
+    loop_.attach(fds_[0], ec);
+    ASSERT_FALSE(ec);
+
+    std::string received;
+    auto reader = [&]() -> Task<void>
+    {
+        char buffer[16];
+        while (received.size() < 5)
+        {
+            ssize_t n = ::read(fds_[0], buffer, sizeof(buffer));
+            if (n > 0)
+            {
+                received.append(buffer, n);
+            }
+            else
+            {
+                co_await loop_.readable(fds_[0]);
+            }
+        }
+        loop_.stop();
+    };
+
+    loop_.spawn(reader());
+    std::thread writer(
+        [this]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            ASSERT_EQ(::write(fds_[1], "he", 2), 2);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            ASSERT_EQ(::write(fds_[1], "llo", 3), 3);
+        });
+
+    loop_.run();
+    writer.join();
+    EXPECT_EQ(received, "hello");
+}
+
+TEST_F(EventLoopTest, DetachResumesWaiterWithError)
+{
+    std::error_code ec;
+    loop_.attach(fds_[0], ec);
+    ASSERT_FALSE(ec);
+
+    EventType result = EventType::None;
+    auto waiter = [&]() -> Task<void>
+    {
+        result = co_await loop_.readable(fds_[0]);
+        loop_.stop();
+    };
+
+    loop_.spawn(waiter());
+    loop_.runOnce(0, ec);
+    loop_.detach(fds_[0], ec);
+    loop_.run();
+
+    EXPECT_EQ(result, EventType::Error);
+}
+
+TEST_F(EventLoopTest, SleepFor)
+{
+    auto sleeper = [&]() -> Task<void>
+    {
+        co_await loop_.sleepFor(std::chrono::milliseconds(30));
+        loop_.stop();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    loop_.spawn(sleeper());
+    loop_.run();
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+}
+
+TEST_F(EventLoopTest, HopsBetweenPoolAndLoop)
+{
+    casket::thread::ThreadPool pool(2);
+    std::thread::id loopThread = std::this_thread::get_id();
+    std::thread::id workerThread;
+    std::thread::id resumedThread;
+
+    auto handler = [&]() -> Task<void>
+    {
+        co_await pool.schedule();
+        workerThread = std::this_thread::get_id();
+        co_await loop_.schedule();
+        resumedThread = std::this_thread::get_id();
+        loop_.stop();
+    };
+
+    loop_.spawn(handler());
+    loop_.run();
+
+    EXPECT_NE(workerThread, loopThread);
+    EXPECT_EQ(resumedThread, loopThread);
+}
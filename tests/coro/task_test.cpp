@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <casket/coro/task.hpp>
+#include <casket/thread/pool.hpp>
+
+using namespace casket;
+using casket::thread::ThreadPool;
+
+namespace
+{
+
+Task<int> Value(int value)
+{
+    co_return value;
+}
+
+Task<int> Sum(int a, int b)
+{
+    int x = co_await Value(a);
+    int y = co_await Value(b);
+    co_return x + y;
+}
+
+Task<void> Throw()
+{
+    throw std::runtime_error("boom");
+    co_return;
+}
+
+Task<int> Chain(int depth)
+{
+    if (depth == 0)
+    {
+        co_return 0;
+    }
+    co_return 1 + co_await Chain(depth - 1);
+}
+
+Task<std::thread::id> WorkerId(ThreadPool& pool)
+{
+    co_await pool.schedule();
+    co_return std::this_thread::get_id();
+}
+
+Task<int> SlowValue(ThreadPool& pool, int value, std::chrono::milliseconds delay)
+{
+    co_await pool.schedule();
+    std::this_thread::sleep_for(delay);
+    co_return value;
+}
+
+} // namespace
+
+TEST(TaskTest, ReturnsValue)
+{
+    EXPECT_EQ(SyncWait(Sum(2, 3)), 5);
+}
+
+TEST(TaskTest, PropagatesException)
+{
+    EXPECT_THROW(SyncWait(Throw()), std::runtime_error);
+}
+
+TEST(TaskTest, LvalueAwaitKeepsResult)
+{
+    auto outer = []() -> Task<std::string>
+    {
+        auto inner = []() -> Task<std::string> { co_return std::string("value"); }();
+        const std::string& ref = co_await inner;
+        co_return ref + "!";
+    };
+    EXPECT_EQ(SyncWait(outer()), "value!");
+}
+
+TEST(TaskTest, DeepChainDoesNotOverflowStack)
+{
+#if (!defined(__OPTIMIZE__) && !defined(__clang__)) || defined(__SANITIZE_ADDRESS__)
+    GTEST_SKIP() << "symmetric transfer is a tail call only in optimized builds without ASan";
+#endif
+    EXPECT_EQ(SyncWait(Chain(1000000)), 1000000);
+}
+
+TEST(TaskTest, ScheduleResumesOnWorker)
+{
+    ThreadPool pool(2);
+    EXPECT_NE(SyncWait(WorkerId(pool)), std::this_thread::get_id());
+}
+
+TEST(TaskTest, ScheduleAfterShutdownContinuesInline)
+{
+    ThreadPool pool(1);
+    pool.shutdown();
+    EXPECT_EQ(SyncWait(WorkerId(pool)), std::this_thread::get_id());
+}
+
+TEST(TaskTest, WhenAllVector)
+{
+    ThreadPool pool(4);
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 16; ++i)
+    {
+        tasks.push_back(SlowValue(pool, i, std::chrono::milliseconds(1)));
+    }
+
+    auto values = SyncWait(WhenAll(std::move(tasks)));
+    ASSERT_EQ(values.size(), 16U);
+    for (int i = 0; i < 16; ++i)
+    {
+        EXPECT_EQ(values[i], i);
+    }
+}
+
+TEST(TaskTest, WhenAllRunsConcurrently)
+{
+    ThreadPool pool(4);
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 4; ++i)
+    {
+        tasks.push_back(SlowValue(pool, i, std::chrono::milliseconds(100)));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    SyncWait(WhenAll(std::move(tasks)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(350));
+}
+
+TEST(TaskTest, WhenAllTuple)
+{
+    ThreadPool pool(2);
+    auto text = [](ThreadPool& pool) -> Task<std::string>
+    {
+        co_await pool.schedule();
+        co_return std::string("text");
+    };
+
+    auto [number, string] = SyncWait(WhenAll(SlowValue(pool, 7, std::chrono::milliseconds(1)), text(pool)));
+    EXPECT_EQ(number, 7);
+    EXPECT_EQ(string, "text");
+}
+
+TEST(TaskTest, WhenAllRethrowsAfterEveryTaskFinished)
+{
+    std::vector<Task<void>> tasks;
+    tasks.push_back(Throw());
+    tasks.push_back(Throw());
+    EXPECT_THROW(SyncWait(WhenAll(std::move(tasks))), std::runtime_error);
+}
+
+TEST(TaskTest, WhenAnyReturnsFirst)
+{
+    ThreadPool pool(4);
+    std::vector<Task<int>> tasks;
+    tasks.push_back(SlowValue(pool, 1, std::chrono::milliseconds(300)));
+    tasks.push_back(SlowValue(pool, 2, std::chrono::milliseconds(1)));
+
+    auto result = SyncWait(WhenAny(std::move(tasks)));
+    EXPECT_EQ(result.index, 1U);
+    EXPECT_EQ(result.value, 2);
+}
+
+TEST(TaskTest, WhenAnySynchronousCompletion)
+{
+    std::vector<Task<int>> tasks;
+    tasks.push_back(Value(10));
+    tasks.push_back(Value(20));
+
+    auto result = SyncWait(WhenAny(std::move(tasks)));
+    EXPECT_EQ(result.index, 0U);
+    EXPECT_EQ(result.value, 10);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include <casket/multiplexing/epoll_poller.hpp>
+
+using namespace casket;
+
+class EpollPollerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds_), 0);
+    }
+
+    void TearDown() override
+    {
+        ::close(fds_[0]);
+        ::close(fds_[1]);
+    }
+
+    int waitFor(EpollPoller& poller, int timeoutMs = 50)
+    {
+        std::error_code ec;
+        int count = poller.wait(events_, 8, timeoutMs, ec);
+        EXPECT_FALSE(ec) << ec.message();
+        return count;
+    }
+
+    int fds_[2]{-1, -1};
+    PollEvent events_[8];
+};
+
+TEST_F(EpollPollerTest, OneShotIsRearmedByModify)
+{
+    EpollPoller poller;
+    EventType events = EventType::Readable | EventType::OneShot;
+    poller.add(fds_[0], events);
+    ASSERT_EQ(::write(fds_[1], "x", 1), 1);
+
+    ASSERT_EQ(waitFor(poller), 1);
+    EXPECT_EQ(waitFor(poller), 0);
+
+    poller.modify(fds_[0], events);
+    EXPECT_EQ(waitFor(poller), 1);
+    EXPECT_EQ(waitFor(poller), 0);
+}
+
+TEST_F(EpollPollerTest, UnchangedModifyIsSkipped)
+{
+    EpollPoller poller;
+    EventType events = EventType::Readable | EventType::EdgeTriggered;
+    poller.add(fds_[0], events);
+    ASSERT_EQ(::write(fds_[1], "x", 1), 1);
+    ASSERT_EQ(waitFor(poller), 1);
+
+    // EPOLL_CTL_MOD would report the still readable socket again.
+    poller.modify(fds_[0], events);
+    EXPECT_EQ(waitFor(poller), 0);
+
+    poller.modify(fds_[0], events | EventType::Writable);
+    ASSERT_EQ(waitFor(poller), 1);
+    EXPECT_NE(events_[0].revents & EventType::Writable, EventType::None);
+}
+
+TEST_F(EpollPollerTest, ExclusiveWakesAndRejectsModify)
+{
+    int efd = ::eventfd(0, EFD_NONBLOCK);
+    ASSERT_GE(efd, 0);
+
+    EpollPoller first;
+    EpollPoller second;
+    std::error_code ec;
+    first.add(efd, EventType::Readable | EventType::Exclusive, ec);
+    ASSERT_FALSE(ec) << ec.message();
+    second.add(efd, EventType::Readable | EventType::Exclusive, ec);
+    ASSERT_FALSE(ec) << ec.message();
+
+    uint64_t one = 1;
+    ASSERT_EQ(::write(efd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    EXPECT_GE(waitFor(first) + waitFor(second), 1);
+
+    first.modify(efd, EventType::Readable, ec);
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+    ::close(efd);
+}
+
+TEST_F(EpollPollerTest, BatchRegistration)
+{
+    int others[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, others), 0);
+
+    EpollPoller poller;
+    int tags[3];
+    std::vector<PollRegistration> items = {
+        {fds_[0], EventType::Readable, &tags[0]},
+        {others[0], EventType::Readable, &tags[1]},
+        {fds_[0], EventType::Readable, &tags[2]},
+    };
+
+    std::error_code ec;
+    EXPECT_EQ(poller.addBatch(items.data(), items.size(), ec), 2u);
+    EXPECT_EQ(ec, std::errc::file_exists);
+
+    items.pop_back();
+    items[0].events = EventType::Writable;
+    EXPECT_EQ(poller.modifyBatch(items.data(), items.size(), ec), 2u);
+    EXPECT_FALSE(ec);
+
+    ASSERT_EQ(waitFor(poller), 1);
+    EXPECT_EQ(events_[0].userData, &tags[0]);
+
+    ::close(others[0]);
+    ::close(others[1]);
+}
+
+TEST(EpollPollerEventsTest, EventBufferAdaptsToLoad)
+{
+    int source = ::eventfd(1, EFD_NONBLOCK);
+    ASSERT_GE(source, 0);
+    std::vector<int> fds;
+    for (int i = 0; i < 200; ++i)
+    {
+        fds.push_back(::dup(source));
+        ASSERT_GE(fds.back(), 0);
+    }
+
+    EpollPoller poller(16);
+    for (int fd : fds)
+    {
+        poller.add(fd, EventType::Readable);
+    }
+
+    std::vector<PollEvent> events(512);
+    std::error_code ec;
+    std::vector<int> counts;
+    for (int i = 0; i < 5; ++i)
+    {
+        counts.push_back(poller.wait(events.data(), static_cast<int>(events.size()), 0, ec));
+        ASSERT_FALSE(ec);
+    }
+    EXPECT_EQ(counts, (std::vector<int>{16, 32, 64, 128, 200}));
+    EXPECT_EQ(poller.eventCapacity(), 256u);
+
+    EXPECT_EQ(poller.wait(events.data(), 10, 0, ec), 10);
+    EXPECT_EQ(poller.eventCapacity(), 256u);
+
+    for (int fd : fds)
+    {
+        poller.remove(fd);
+        ::close(fd);
+    }
+    ::close(source);
+
+    for (int i = 0; i < 64 * 5; ++i)
+    {
+        ASSERT_EQ(poller.wait(events.data(), static_cast<int>(events.size()), 0, ec), 0);
+    }
+    EXPECT_EQ(poller.eventCapacity(), 16u);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <casket/multiplexing/epoll_poller.hpp>
+#include <casket/multiplexing/fd_table.hpp>
+
+using namespace casket;
+
+TEST(FdTableTest, AllocatesChunksLazily)
+{
+    FdTable<void*> table(1 << 20);
+    EXPECT_GE(table.capacity(), size_t{1} << 20);
+
+    size_t empty = table.memoryUsage();
+    EXPECT_EQ(table.find(0), nullptr);
+    EXPECT_EQ(table.find(500000), nullptr);
+    EXPECT_EQ(table.find(-1), nullptr);
+
+    void** entry = table.acquire(500000);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(*entry, nullptr);
+    EXPECT_EQ(table.memoryUsage(), empty + 4096);
+
+    int value = 0;
+    *entry = &value;
+    EXPECT_EQ(table.find(500000), entry);
+    EXPECT_EQ(*table.find(500001), nullptr);
+    EXPECT_EQ(table.find(0), nullptr);
+    EXPECT_EQ(table.acquire(-1), nullptr);
+}
+
+TEST(FdTableTest, GrowsBeyondInitialCapacity)
+{
+    FdTable<int> table(16);
+    size_t capacity = table.capacity();
+
+    int fd = static_cast<int>(capacity * 10 + 3);
+    EXPECT_EQ(table.find(fd), nullptr);
+    ASSERT_NE(table.acquire(fd), nullptr);
+    *table.acquire(fd) = 42;
+    EXPECT_GT(table.capacity(), static_cast<size_t>(fd));
+    EXPECT_EQ(*table.find(fd), 42);
+}
+
+TEST(FdTableTest, ForEachAndClear)
+{
+    FdTable<int> table(1 << 16);
+    *table.acquire(3) = 1;
+    *table.acquire(60000) = 2;
+
+    int sum = 0;
+    size_t visited = 0;
+    table.forEach(
+        [&](int fd, int& value)
+        {
+            if (value)
+            {
+                sum += fd * value;
+            }
+            ++visited;
+        });
+    EXPECT_EQ(sum, 3 + 120000);
+    EXPECT_EQ(visited, 2 * FdTable<int>::kChunkEntries);
+
+    table.clear();
+    EXPECT_EQ(table.find(3), nullptr);
+    EXPECT_EQ(table.find(60000), nullptr);
+    EXPECT_EQ(*table.acquire(3), 0);
+}
+
+TEST(FdTableTest, EpollPollerAcceptsDescriptorsAboveTenThousand)
+{
+    rlimit limit;
+    ASSERT_EQ(::getrlimit(RLIMIT_NOFILE, &limit), 0);
+    const rlim_t wanted = 20000;
+    if (limit.rlim_cur < wanted)
+    {
+        rlimit raised = limit;
+        raised.rlim_cur = limit.rlim_max == RLIM_INFINITY || limit.rlim_max >= wanted ? wanted : limit.rlim_max;
+        if (raised.rlim_cur < wanted || ::setrlimit(RLIMIT_NOFILE, &raised) != 0)
+        {
+            GTEST_SKIP() << "RLIMIT_NOFILE cannot be raised to " << wanted;
+        }
+    }
+
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+    int high = ::dup2(fds[0], 15000);
+    ASSERT_EQ(high, 15000);
+
+    {
+        EpollPollerWithPool poller;
+        std::error_code ec;
+        int tag = 0;
+        poller.add(&tag, high, EventType::Readable, ec);
+        ASSERT_FALSE(ec) << ec.message();
+
+        ASSERT_EQ(::write(fds[1], "x", 1), 1);
+        PollEvent events[4];
+        ASSERT_EQ(poller.wait(events, 4, 1000, ec), 1);
+        EXPECT_EQ(events[0].fd, high);
+        EXPECT_EQ(events[0].userData, &tag);
+
+        poller.remove(high, ec);
+        EXPECT_FALSE(ec);
+        poller.remove(high, ec);
+        EXPECT_EQ(ec, std::errc::no_such_file_or_directory);
+    }
+
+    ::close(high);
+    ::close(fds[0]);
+    ::close(fds[1]);
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+}
+
+TEST(FdTableTest, PoolContextGrowsPastOneChunk)
+{
+    PoolContext contexts;
+    std::vector<PoolContext::ContextPtr> created;
+    for (int i = 0; i < 25000; ++i)
+    {
+        auto ctx = contexts.create();
+        ASSERT_NE(ctx, nullptr);
+        ctx->fd = i;
+        created.push_back(ctx);
+    }
+    EXPECT_EQ(contexts.usedCount(), 25000u);
+
+    for (size_t i = 0; i < created.size(); i += 2)
+    {
+        contexts.destroy(created[i]);
+    }
+    EXPECT_EQ(contexts.usedCount(), 12500u);
+    EXPECT_EQ(created[1]->fd, 1);
+    EXPECT_EQ(created[24999]->fd, 24999);
+}
+
+TEST(FdTableBenchmark, MemoryAndLookupCost)
+{
+    for (int count : {1000, 100000, 1000000})
+    {
+        FdTable<void*> table(static_cast<size_t>(count));
+        size_t directory = table.memoryUsage();
+        for (int fd = 0; fd < count; ++fd)
+        {
+            *table.acquire(fd) = &table;
+        }
+
+        const int lookups = 4000000;
+        size_t hits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < lookups; ++i)
+        {
+            int fd = static_cast<int>((static_cast<unsigned>(i) * 2654435761u) % static_cast<unsigned>(count));
+            hits += *table.find(fd) != nullptr;
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+
+        EXPECT_EQ(hits, static_cast<size_t>(lookups));
+        std::printf("[ FdTable  ] %7d fds: directory %zu B, full %zu B, %.2f ns/lookup\n", count, directory,
+                    table.memoryUsage(), elapsed.count() / lookups);
+    }
+}
@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <string>
+#include <vector>
+
+#include <casket/multiplexing/adaptive_poller.hpp>
+
+using namespace casket;
+
+class IoUringPollerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!IoUringPoller::isSupported())
+        {
+            GTEST_SKIP() << "io_uring is not available";
+        }
+
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds_), 0);
+    }
+
+    void TearDown() override
+    {
+        for (int fd : fds_)
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+        }
+    }
+
+    int waitFor(IoUringPoller& poller, std::vector<PollEvent>& events, int timeoutMs = 1000)
+    {
+        std::error_code ec;
+        int count = poller.wait(events.data(), static_cast<int>(events.size()), timeoutMs, ec);
+        EXPECT_FALSE(ec) << ec.message();
+        return count;
+    }
+
+    void writeAll(int fd, const std::string& data)
+    {
+        ASSERT_EQ(::write(fd, data.data(), data.size()), static_cast<ssize_t>(data.size()));
+    }
+
+    int fds_[2]{-1, -1};
+};
+
+TEST_F(IoUringPollerTest, ReportsReadable)
+{
+    IoUringPoller poller;
+    std::vector<PollEvent> events(8);
+    int tag = 0;
+
+    poller.add(&tag, fds_[0], EventType::Readable);
+    EXPECT_EQ(waitFor(poller, events, 0), 0);
+
+    writeAll(fds_[1], "x");
+    ASSERT_EQ(waitFor(poller, events), 1);
+    EXPECT_EQ(events[0].fd, fds_[0]);
+    EXPECT_EQ(events[0].userData, &tag);
+    EXPECT_NE(events[0].revents & EventType::Readable, EventType::None);
+    EXPECT_EQ(events[0].revents & EventType::Completion, EventType::None);
+}
+
+TEST_F(IoUringPollerTest, LevelTriggeredRepeatsUntilDrained)
+{
+    IoUringPoller poller;
+    std::vector<PollEvent> events(8);
+
+    poller.add(fds_[0], EventType::Readable);
+    writeAll(fds_[1], "abc");
+
+    ASSERT_EQ(waitFor(poller, events), 1);
+    ASSERT_EQ(waitFor(poller, events), 1);
+
+    char buffer[8];
+    ASSERT_EQ(::read(fds_[0], buffer, sizeof(buffer)), 3);
+    EXPECT_EQ(waitFor(poller, events, 50), 0);
+}
+
+TEST_F(IoUringPollerTest, EdgeTriggeredReportsOnce)
+{
+    IoUringPoller poller;
+    std::vector<PollEvent> events(8);
+
+    poller.add(fds_[0], EventType::Readable | EventType::EdgeTriggered);
+    writeAll(fds_[1], "abc");
+
+    ASSERT_EQ(waitFor(poller, events), 1);
+    EXPECT_EQ(waitFor(poller, events, 50), 0);
+
+    writeAll(fds_[1], "d");
+    EXPECT_EQ(waitFor(poller, events), 1);
+}
+
+TEST_F(IoUringPollerTest, OneShotIsRearmedByModify)
+{
+    IoUringPoller poller;
+    std::vector<PollEvent> events(8);
+    EventType interest = EventType::Readable | EventType::OneShot;
+
+    poller.add(fds_[0], interest);
+    writeAll(fds_[1], "x");
+
+    ASSERT_EQ(waitFor(poller, events), 1);
+    EXPECT_EQ(waitFor(poller, events, 50), 0);
+
+    poller.modify(fds_[0], interest);
+    EXPECT_EQ(waitFor(poller, events), 1);
+}
+
+TEST_F(IoUringPollerTest, ModifyAndRemove)
+{
+    IoUringPoller poller;
+    std::vector<PollEvent> events(8);
+
+    poller.add(fds_[0], EventType::Readable);
+    EXPECT_EQ(waitFor(poller, events, 0), 0);
+
+    poller.modify(fds_[0], EventType::Writable);
+    ASSERT_EQ(waitFor(poller, events), 1);
+    EXPECT_NE(events[0].revents & EventType::Writable, EventType::None);
+
+    poller.remove(fds_[0]);
+    writeAll(fds_[1], "x");
+    EXPECT_EQ(waitFor(poller, events, 50), 0);
+
+    std::error_code ec;
+    poller.remove(fds_[0], ec);
+    EXPECT_EQ(ec, std::errc::no_such_file_or_directory);
+    poller.add(fds_[0], EventType::Readable, ec);
+    EXPECT_FALSE(ec);
+    poller.add(fds_[0], EventType::Readable, ec);
+    EXPECT_EQ(ec, std::errc::file_exists);
+}
+
+TEST_F(IoUringPollerTest, MultishotRecvWithProvidedBuffers)
+{
+    IoUringPoller poller;
+    std::vector<PollEvent> events(8);
+    std::error_code ec;
+
+    if (!poller.setupBufferRing(4, 64, ec))
+    {
+        GTEST_SKIP() << "multishot recv is not available: " << ec.message();
+    }
+
+    poller.add(fds_[0], EventType::None);
+    poller.recvMultishot(fds_[0], ec);
+    ASSERT_FALSE(ec);
+
+    std::string received;
+    for (int round = 0; round < 10; ++round)
+    {
+        std::string chunk = "chunk-" + std::to_string(round);
+        writeAll(fds_[1], chunk);
+
+        while (received.size() < (round + 1) * chunk.size())
+        {
+            int count = waitFor(poller, events);
+            ASSERT_GT(count, 0);
+            for (int i = 0; i < count; ++i)
+            {
+                ASSERT_NE(events[i].revents & EventType::Completion, EventType::None);
+                ASSERT_NE(events[i].revents & EventType::Readable, EventType::None);
+                ASSERT_NE(events[i].data, nullptr);
+                received.append(reinterpret_cast<const char*>(events[i].data), events[i].result);
+            }
+        }
+    }
+    EXPECT_EQ(received.substr(0, 14), "chunk-0chunk-1");
+
+    ::close(fds_[1]);
+    fds_[1] = -1;
+    ASSERT_EQ(waitFor(poller, events), 1);
+    EXPECT_NE(events[0].revents & EventType::HangUp, EventType::None);
+    EXPECT_EQ(events[0].result, 0);
+}
+
+TEST_F(IoUringPollerTest, RecvResumesAfterBufferRingRunsDry)
+{
+    IoUringPoller poller;
+    std::vector<PollEvent> events(16);
+    std::error_code ec;
+
+    if (!poller.setupBufferRing(2, 16, ec))
+    {
+        GTEST_SKIP() << "multishot recv is not available: " << ec.message();
+    }
+
+    poller.add(fds_[0], EventType::None);
+    writeAll(fds_[1], std::string(200, 'q'));
+    poller.recvMultishot(fds_[0], ec);
+    ASSERT_FALSE(ec);
+
+    size_t received = 0;
+    for (int rounds = 0; received < 200 && rounds < 100; ++rounds)
+    {
+        int count = waitFor(poller, events, 100);
+        for (int i = 0; i < count; ++i)
+        {
+            ASSERT_GT(events[i].result, 0);
+            received += static_cast<size_t>(events[i].result);
+        }
+    }
+    EXPECT_EQ(received, 200u);
+}
+
+TEST_F(IoUringPollerTest, LinkedSendsKeepOrder)
+{
+    IoUringPoller poller;
+    std::vector<PollEvent> events(8);
+    std::error_code ec;
+
+    const std::string parts[] = {"first,", "second,", "third"};
+    poller.add(fds_[1], EventType::None);
+    for (const auto& part : parts)
+    {
+        poller.send(fds_[1], part.data(), part.size(), ec);
+        ASSERT_FALSE(ec);
+    }
+
+    int completed = 0;
+    while (completed < 3)
+    {
+        int count = waitFor(poller, events);
+        ASSERT_GT(count, 0);
+        for (int i = 0; i < count; ++i)
+        {
+            EXPECT_NE(events[i].revents & (EventType::Writable | EventType::Completion), EventType::None);
+            EXPECT_EQ(events[i].result, static_cast<int32_t>(parts[completed].size()));
+            ++completed;
+        }
+    }
+
+    char buffer[64];
+    ssize_t n = ::read(fds_[0], buffer, sizeof(buffer));
+    ASSERT_GT(n, 0);
+    EXPECT_EQ(std::string(buffer, n), "first,second,third");
+}
+
+TEST(AdaptivePollerTest, SelectsBackend)
+{
+    AdaptivePoller epoll(PollerBackend::Epoll);
+    EXPECT_EQ(epoll.backend(), PollerBackend::Epoll);
+    EXPECT_EQ(epoll.getIoUring(), nullptr);
+
+    AdaptivePoller preferred(PollerBackend::IoUring);
+    EXPECT_TRUE(preferred.isValid());
+    if (IoUringPoller::isSupported())
+    {
+        EXPECT_EQ(preferred.backend(), PollerBackend::IoUring);
+        EXPECT_NE(preferred.getIoUring(), nullptr);
+    }
+    else
+    {
+        EXPECT_EQ(preferred.backend(), PollerBackend::Epoll);
+    }
+}
+
+TEST(AdaptivePollerTest, SameBehaviourOnBothBackends)
+{
+    for (auto backend : {PollerBackend::Epoll, PollerBackend::IoUring})
+    {
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+
+        AdaptivePoller poller(backend);
+        std::vector<PollEvent> events(4);
+        std::error_code ec;
+
+        poller.add(fds[0], EventType::Readable | EventType::HangUp, ec);
+        ASSERT_FALSE(ec);
+        ASSERT_EQ(::write(fds[1], "x", 1), 1);
+
+        int count = poller.wait(events.data(), 4, 1000, ec);
+        ASSERT_EQ(count, 1);
+        EXPECT_EQ(events[0].fd, fds[0]);
+        EXPECT_NE(events[0].revents & EventType::Readable, EventType::None);
+
+        poller.remove(fds[0], ec);
+        EXPECT_FALSE(ec);
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+}
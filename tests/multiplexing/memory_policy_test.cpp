@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+#include <casket/multiplexing/epoll_poller.hpp>
+
+using namespace casket;
+
+namespace
+{
+
+struct Counted
+{
+    static int live;
+
+    Counted()
+    {
+        ++live;
+    }
+
+    ~Counted()
+    {
+        --live;
+    }
+
+    int value{0};
+};
+
+int Counted::live = 0;
+
+} // namespace
+
+TEST(PoolMemoryPolicyTest, ClearDestroysOnlyLiveObjects)
+{
+    Counted::live = 0;
+    {
+        PoolMemoryPolicy<Counted, 64> pool;
+        std::vector<Counted*> objects;
+        for (int i = 0; i < 200; ++i)
+        {
+            objects.push_back(pool.create());
+        }
+        for (size_t i = 0; i < objects.size(); i += 3)
+        {
+            pool.destroy(objects[i]);
+        }
+        EXPECT_EQ(Counted::live, 133);
+        EXPECT_EQ(pool.usedCount(), 133u);
+        EXPECT_EQ(pool.capacity(), 256u);
+
+        pool.clear();
+        EXPECT_EQ(Counted::live, 0);
+        EXPECT_EQ(pool.usedCount(), 0u);
+        EXPECT_EQ(pool.capacity(), 256u);
+
+        objects.clear();
+        for (int i = 0; i < 256; ++i)
+        {
+            objects.push_back(pool.create());
+        }
+        EXPECT_EQ(pool.capacity(), 256u);
+        EXPECT_EQ(std::set<Counted*>(objects.begin(), objects.end()).size(), 256u);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
+
+TEST(PoolMemoryPolicyTest, ForEachVisitsLiveObjects)
+{
+    PoolMemoryPolicy<Counted, 100> pool;
+    std::vector<Counted*> objects;
+    for (int i = 0; i < 250; ++i)
+    {
+        objects.push_back(pool.create());
+        objects.back()->value = i;
+    }
+    for (int i = 0; i < 250; i += 2)
+    {
+        pool.destroy(objects[i]);
+    }
+
+    int count = 0;
+    int sum = 0;
+    pool.forEach(
+        [&](Counted& object)
+        {
+            ++count;
+            sum += object.value;
+        });
+    EXPECT_EQ(count, 125);
+    EXPECT_EQ(sum, 125 * 125);
+}
+
+TEST(PoolMemoryPolicyTest, DetectsForeignAndStalePointers)
+{
+    PoolMemoryPolicy<Counted, 16> pool;
+    Counted* object = pool.create();
+    Counted outside;
+
+    EXPECT_TRUE(pool.owns(object));
+    EXPECT_FALSE(pool.owns(&outside));
+
+    pool.destroy(object);
+    EXPECT_FALSE(pool.owns(object));
+
+    pool.destroy(object);
+    pool.destroy(&outside);
+    EXPECT_EQ(pool.usedCount(), 0u);
+}
+
+TEST(PoolMemoryPolicyBenchmark, PollerSetupAndTeardownWithFullPool)
+{
+    rlimit limit;
+    ASSERT_EQ(::getrlimit(RLIMIT_NOFILE, &limit), 0);
+    size_t count = limit.rlim_cur > 10064 ? 10000 : static_cast<size_t>(limit.rlim_cur) - 64;
+
+    int source = ::eventfd(0, EFD_NONBLOCK);
+    ASSERT_GE(source, 0);
+    std::vector<int> fds;
+    for (size_t i = 0; i < count; ++i)
+    {
+        int fd = ::dup(source);
+        ASSERT_GE(fd, 0);
+        fds.push_back(fd);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Clock::duration setup{};
+    Clock::duration teardown{};
+    for (int round = 0; round < 3; ++round)
+    {
+        auto start = Clock::now();
+        {
+            auto poller = std::make_unique<EpollPollerWithPool>();
+            std::error_code ec;
+            for (int fd : fds)
+            {
+                poller->add(fd, EventType::Readable, ec);
+                ASSERT_FALSE(ec) << ec.message();
+            }
+            ASSERT_EQ(poller->getUsedContextsCount(), count);
+
+            auto middle = Clock::now();
+            setup += middle - start;
+            poller.reset();
+            teardown += Clock::now() - middle;
+        }
+    }
+
+    auto clearStart = Clock::now();
+    PoolMemoryPolicy<ContextData> pool;
+    for (int i = 0; i < 100000; ++i)
+    {
+        ASSERT_NE(pool.create(), nullptr);
+    }
+    pool.clear();
+    auto clearTime = Clock::now() - clearStart;
+
+    using Ms = std::chrono::duration<double, std::milli>;
+    std::printf("[ Pool     ] %zu contexts: setup %.2f ms, teardown %.2f ms; 100000 create+clear %.2f ms\n", count,
+                Ms(setup).count() / 3, Ms(teardown).count() / 3, Ms(clearTime).count());
+
+    for (int fd : fds)
+    {
+        ::close(fd);
+    }
+    ::close(source);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <casket/server/acceptor_server.hpp>
+
+#include "common/server_test_utils.hpp"
+
+using namespace casket;
+using namespace casket::test;
+
+namespace
+{
+
+const char* const kSocketPath = "/tmp/casket_acceptor_server_test.sock";
+
+} // namespace
+
+class AcceptorServerTest : public ::testing::TestWithParam<WorkerSelection>
+{
+};
+
+TEST_P(AcceptorServerTest, HandsConnectionsToWorkers)
+{
+    AcceptorServerConfig config;
+    config.workers = 3;
+    config.selection = GetParam();
+    config.acceptBatch = 8;
+
+    AcceptorServer<UnixSocket> server(config);
+    server.setConnectionHandler(EchoHandler<UnixSocket>);
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(kSocketPath, -1, 256, ec)) << ec.message();
+    server.start();
+
+    std::vector<UnixSocket> clients(30);
+    for (size_t i = 0; i < clients.size(); ++i)
+    {
+        ASSERT_TRUE(clients[i].connect(kSocketPath, false, ec)) << ec.message();
+    }
+    for (size_t i = 0; i < clients.size(); ++i)
+    {
+        std::string message = "hello-" + std::to_string(i);
+        EXPECT_EQ(Exchange(clients[i], message), message);
+    }
+
+    // Least-connections reads the load of busy workers, allow it some slack.
+    size_t slack = GetParam() == WorkerSelection::RoundRobin ? 0 : 3;
+    for (size_t i = 0; i < server.getWorkerCount(); ++i)
+    {
+        EXPECT_GE(server.getWorker(i).getClientCount() + slack, 10u) << "worker " << i;
+        EXPECT_LE(server.getWorker(i).getClientCount(), 10u + slack) << "worker " << i;
+    }
+
+    ServerStatistics total;
+    server.aggregateStatistics(total);
+    EXPECT_EQ(total.totalConnections.load(), clients.size());
+
+    server.stop();
+    EXPECT_FALSE(server.isRunning());
+}
+
+INSTANTIATE_TEST_SUITE_P(Selection, AcceptorServerTest,
+                         ::testing::Values(WorkerSelection::RoundRobin, WorkerSelection::LeastConnections));
+
+TEST(AcceptorServerStopTest, DrainsWorkersAfterAcceptorStops)
+{
+    AcceptorServerConfig config;
+    config.workers = 2;
+
+    AcceptorServer<UnixSocket> server(config);
+    server.setConnectionHandler(EchoHandler<UnixSocket>);
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(kSocketPath, -1, 64, ec)) << ec.message();
+    server.start();
+
+    UnixSocket client;
+    ASSERT_TRUE(client.connect(kSocketPath, false, ec)) << ec.message();
+    ASSERT_EQ(Exchange(client, "ping"), "ping");
+
+    std::thread closer(
+        [&client]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            client.close();
+        });
+
+    auto started = std::chrono::steady_clock::now();
+    server.stop(std::chrono::seconds(5));
+    auto elapsed = std::chrono::steady_clock::now() - started;
+    closer.join();
+
+    EXPECT_GE(elapsed, std::chrono::milliseconds(150));
+    EXPECT_LT(elapsed, std::chrono::seconds(3));
+}
@@ -0,0 +1,711 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <casket/client/generic_client.hpp>
+#include <casket/server/generic_server.hpp>
+
+#include "common/server_test_utils.hpp"
+
+using namespace casket;
+using namespace casket::test;
+
+namespace
+{
+
+std::vector<uint8_t> PackTexts(const std::vector<std::string>& texts)
+{
+    std::vector<uint8_t> bytes(4096);
+    Packer packer(bytes.data(), bytes.size());
+    for (const auto& text : texts)
+    {
+        packer.pack(text);
+    }
+    bytes.resize(packer.position());
+    return bytes;
+}
+
+} // namespace
+
+TEST(GenericServerAcceptTest, DrainsBacklogInBatches)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServerConfig config;
+    config.acceptBatch = 64;
+    GenericServer<UnixSocket> server(config);
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 256, ec)) << ec.message();
+
+    std::vector<UnixSocket> clients(100);
+    for (auto& client : clients)
+    {
+        ASSERT_TRUE(client.connect(path, false, ec)) << ec.message();
+    }
+
+    server.start();
+    for (int i = 0; i < 10 && server.getClientCount() < clients.size(); ++i)
+    {
+        server.step();
+    }
+
+    const auto& stats = server.getStatistics();
+    EXPECT_EQ(server.getClientCount(), clients.size());
+    EXPECT_EQ(stats.totalConnections.load(), clients.size());
+    EXPECT_EQ(stats.acceptWakeups.load(), 2u);
+
+    uint64_t latencies = 0;
+    for (const auto& bucket : stats.acceptLatencyBuckets)
+    {
+        latencies += bucket.load();
+    }
+    EXPECT_EQ(latencies, clients.size());
+    EXPECT_GT(stats.getAcceptLatencyPercentileUs(0.99), 0u);
+    EXPECT_LE(stats.getAcceptLatencyPercentileUs(0.5), stats.getAcceptLatencyPercentileUs(0.99));
+
+    server.stop();
+}
+
+TEST(GenericServerAcceptTest, AcceptedSocketsAreNonBlockingAndCloseOnExec)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    UnixSocket listener;
+    std::error_code ec;
+    ASSERT_TRUE(listener.listen(path, 4, ec)) << ec.message();
+
+    UnixSocket client;
+    ASSERT_TRUE(client.connect(path, false, ec)) << ec.message();
+
+    UnixSocket accepted = listener.accept(ec);
+    ASSERT_TRUE(accepted.isValid()) << ec.message();
+    EXPECT_NE(::fcntl(accepted.getFd(), F_GETFL) & O_NONBLOCK, 0);
+    EXPECT_NE(::fcntl(accepted.getFd(), F_GETFD) & FD_CLOEXEC, 0);
+
+    UnixSocket none = listener.accept(ec);
+    EXPECT_FALSE(none.isValid());
+    EXPECT_EQ(ec, std::errc::resource_unavailable_try_again);
+}
+
+TEST(GenericServerIdleTest, ReapsOnlyExpiredClients)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServerConfig config;
+    config.idleTimeout = std::chrono::seconds(1);
+    config.idleCheckInterval = std::chrono::milliseconds(50);
+    config.waitTimeoutMs = 10;
+    GenericServer<UnixSocket> server(config);
+    server.setConnectionHandler(
+        [](Context<UnixSocket>& ctx)
+        {
+            std::error_code ec;
+            ctx.transport.recvBuffer(ctx.readBuffer, ec);
+            ctx.readBuffer.clear();
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 16, ec)) << ec.message();
+    server.start();
+
+    std::vector<UnixSocket> clients(3);
+    for (auto& client : clients)
+    {
+        ASSERT_TRUE(client.connect(path, false, ec)) << ec.message();
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    auto runFor = [&](std::chrono::milliseconds until)
+    {
+        while (std::chrono::steady_clock::now() - started < until)
+        {
+            server.step();
+        }
+    };
+
+    runFor(std::chrono::milliseconds(600));
+    ASSERT_EQ(server.getClientCount(), 3u);
+
+    uint8_t byte = 'x';
+    ASSERT_EQ(clients[1].send(&byte, 1, ec), 1);
+    runFor(std::chrono::milliseconds(1400));
+
+    EXPECT_EQ(server.getClientCount(), 1u);
+    EXPECT_EQ(clients[0].recv(&byte, 1, ec), 0);
+    EXPECT_EQ(clients[2].recv(&byte, 1, ec), 0);
+
+    runFor(std::chrono::milliseconds(1800));
+    EXPECT_EQ(server.getClientCount(), 0u);
+    server.stop();
+}
+
+TEST(GenericServerFramingTest, DispatchesPipelinedMessagesAcrossPartialFrames)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServer<UnixSocket> server;
+    std::vector<std::string> received;
+    std::vector<size_t> perEvent;
+    server.setConnectionHandler(
+        [&](Context<UnixSocket>& ctx)
+        {
+            std::error_code ec;
+            perEvent.push_back(ctx.readThenUnpackAll<TextMessage>(
+                [&](const TextMessage& message) { received.emplace_back(message.text.data(), message.text.size()); },
+                ec));
+            EXPECT_FALSE(ec) << ec.message();
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 16, ec)) << ec.message();
+    server.start();
+
+    UnixSocket client;
+    ASSERT_TRUE(client.connect(path, false, ec)) << ec.message();
+
+    auto bytes = PackTexts({"one", "two", "three", std::string(300, 'x')});
+    size_t split = bytes.size() - 100;
+    ASSERT_EQ(client.send(bytes.data(), split, ec), static_cast<ssize_t>(split));
+    for (int i = 0; i < 20 && received.size() < 3; ++i)
+    {
+        server.step();
+    }
+    ASSERT_EQ(received, (std::vector<std::string>{"one", "two", "three"}));
+    EXPECT_EQ(perEvent.front(), 3u);
+
+    ASSERT_EQ(client.send(bytes.data() + split, bytes.size() - split, ec), 100);
+    for (int i = 0; i < 20 && received.size() < 4; ++i)
+    {
+        server.step();
+    }
+    ASSERT_EQ(received.size(), 4u);
+    EXPECT_EQ(received.back(), std::string(300, 'x'));
+    EXPECT_EQ(server.getClientCount(), 1u);
+    server.stop();
+}
+
+TEST(GenericServerFramingTest, ClosesClientWhenFrameExceedsBufferLimit)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServerConfig config;
+    config.byteBufferSize = 64;
+    config.maxReadBufferSize = 256;
+    GenericServer<UnixSocket> server(config);
+    std::error_code handlerEc;
+    size_t received = 0;
+    server.setConnectionHandler(
+        [&](Context<UnixSocket>& ctx)
+        {
+            received += ctx.readThenUnpackAll<TextMessage>([](const TextMessage&) {}, handlerEc);
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 16, ec)) << ec.message();
+    server.start();
+
+    UnixSocket client;
+    ASSERT_TRUE(client.connect(path, false, ec)) << ec.message();
+    for (int i = 0; i < 20 && server.getClientCount() == 0; ++i)
+    {
+        server.step();
+    }
+
+    auto bytes = PackTexts({"small", std::string(200, 'a'), std::string(1000, 'b')});
+    ASSERT_EQ(client.send(bytes.data(), bytes.size(), ec), static_cast<ssize_t>(bytes.size()));
+    for (int i = 0; i < 20 && server.getClientCount() > 0; ++i)
+    {
+        server.step();
+    }
+
+    EXPECT_EQ(received, 2u);
+    EXPECT_EQ(handlerEc, std::errc::message_size);
+    EXPECT_EQ(server.getClientCount(), 0u);
+    server.stop();
+}
+
+TEST(GenericServerOutputTest, CoalescesQueuedResponsesInOrder)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServerConfig config;
+    config.byteBufferSize = 64;
+    GenericServer<UnixSocket> server(config);
+    std::error_code handlerEc;
+    server.setConnectionHandler(
+        [&](Context<UnixSocket>& ctx)
+        {
+            std::error_code ec;
+            ctx.readThenUnpackAll<TextMessage>(
+                [&](const TextMessage& message)
+                {
+                    ctx.packThenSend(message, handlerEc);
+                    if (message.text == "big")
+                    {
+                        ctx.enqueue(std::vector<uint8_t>(10000, 'z'), handlerEc);
+                    }
+                },
+                ec);
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 16, ec)) << ec.message();
+    server.start();
+
+    UnixSocket client;
+    ASSERT_TRUE(client.connect(path, false, ec)) << ec.message();
+
+    std::vector<std::string> texts;
+    for (int i = 0; i < 40; ++i)
+    {
+        texts.push_back("message-" + std::to_string(i));
+    }
+    texts[20] = "big";
+    auto request = PackTexts(texts);
+    ASSERT_EQ(client.send(request.data(), request.size(), ec), static_cast<ssize_t>(request.size()));
+
+    auto expected = PackTexts(std::vector<std::string>(texts.begin(), texts.begin() + 21));
+    expected.insert(expected.end(), 10000, 'z');
+    auto tail = PackTexts(std::vector<std::string>(texts.begin() + 21, texts.end()));
+    expected.insert(expected.end(), tail.begin(), tail.end());
+
+    for (int i = 0; i < 5; ++i)
+    {
+        server.step();
+    }
+
+    std::vector<uint8_t> reply(expected.size());
+    size_t received = 0;
+    while (received < reply.size())
+    {
+        ssize_t n = client.recv(reply.data() + received, reply.size() - received, ec);
+        ASSERT_GT(n, 0) << ec.message();
+        received += static_cast<size_t>(n);
+    }
+    EXPECT_FALSE(handlerEc) << handlerEc.message();
+    EXPECT_EQ(reply, expected);
+    server.stop();
+}
+
+TEST(GenericServerOutputTest, FlushesResponsesQueuedFromTimers)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServerConfig config;
+    config.waitTimeoutMs = 10;
+    GenericServer<UnixSocket> server(config);
+    std::error_code handlerEc;
+    server.setConnectionHandler(
+        [&](Context<UnixSocket>& ctx)
+        {
+            std::error_code ec;
+            ctx.readThenUnpackAll<TextMessage>(
+                [&](const TextMessage&)
+                {
+                    auto* client = &ctx;
+                    server.getTimers().scheduleAfter(std::chrono::milliseconds(20),
+                                                     [client, &handlerEc]
+                                                     { client->packThenSend(TextMessage{"later"}, handlerEc); });
+                },
+                ec);
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 16, ec)) << ec.message();
+    server.start();
+
+    UnixSocket client;
+    ASSERT_TRUE(client.connect(path, false, ec)) << ec.message();
+
+    auto request = PackTexts({"ping"});
+    ASSERT_EQ(client.send(request.data(), request.size(), ec), static_cast<ssize_t>(request.size()));
+
+    // The client stays silent after the request, only the end-of-step flush can deliver the reply.
+    auto expected = PackTexts({"later"});
+    std::vector<uint8_t> reply(expected.size());
+    ssize_t received = -1;
+    for (int i = 0; i < 50 && received <= 0; ++i)
+    {
+        server.step();
+        received = ::recv(client.getFd(), reply.data(), reply.size(), MSG_DONTWAIT);
+    }
+
+    EXPECT_FALSE(handlerEc) << handlerEc.message();
+    ASSERT_EQ(received, static_cast<ssize_t>(expected.size()));
+    EXPECT_EQ(reply, expected);
+    server.stop();
+}
+
+TEST(GenericServerOutputTest, RejectsOutputBeyondCap)
+{
+    Context<UnixSocket> ctx(64);
+    ctx.maxWriteBufferSize = 256;
+
+    std::error_code ec;
+    std::string text(100, 'a');
+    EXPECT_TRUE(ctx.packThenSend(TextMessage{text}, ec));
+    EXPECT_GT(ctx.writeBuffer.capacity(), 64u);
+    EXPECT_TRUE(ctx.enqueue(std::vector<uint8_t>(100, 'b'), ec));
+    EXPECT_FALSE(ctx.packThenSend(TextMessage{text}, ec));
+    EXPECT_EQ(ec, std::errc::no_buffer_space);
+    EXPECT_FALSE(ctx.enqueue(std::vector<uint8_t>(100, 'b'), ec));
+    EXPECT_EQ(ctx.pendingOutput(), 202u);
+}
+
+TEST(GenericServerBufferTest, ServesClientsWithMirroredRingBuffers)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServerConfig config;
+    config.contextPoolSize = 16;
+    config.byteBufferSize = 4096;
+    GenericServer<UnixSocket, MirroredRingBuffer> server(config);
+    server.setConnectionHandler(
+        [](Context<UnixSocket, MirroredRingBuffer>& ctx)
+        {
+            std::error_code ec;
+            ctx.readThenUnpackAll<TextMessage>([&](const TextMessage& message) { ctx.packThenSend(message, ec); },
+                                               ec);
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 16, ec)) << ec.message();
+    server.start();
+
+    GenericClient<UnixSocket, MirroredRingBuffer> client(4096);
+    ASSERT_TRUE(client.connect(path, -1, false, ec)) << ec.message();
+
+    // Each round trip advances the ring, after a few the messages straddle the wrap point.
+    std::string text(1000, 'r');
+    for (int i = 0; i < 20; ++i)
+    {
+        text[0] = static_cast<char>('a' + i);
+        ASSERT_TRUE(client.send(TextMessage{text}, ec)) << ec.message();
+        for (int j = 0; j < 10 && server.getStatistics().totalBytesSent.load() < (i + 1) * 1003u; ++j)
+        {
+            server.step();
+        }
+
+        auto reply = client.receive<TextMessage>(ec);
+        ASSERT_TRUE(reply) << ec.message();
+        EXPECT_EQ(std::string(reply->text.data(), reply->text.size()), text);
+    }
+    server.stop();
+}
+
+TEST(GenericServerBufferTest, IdleClientsHoldNoBuffers)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServer<UnixSocket> server;
+    server.setConnectionHandler(
+        [](Context<UnixSocket>& ctx)
+        {
+            std::error_code ec;
+            ctx.readThenUnpackAll<TextMessage>([&](const TextMessage& message) { ctx.packThenSend(message, ec); },
+                                               ec);
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 64, ec)) << ec.message();
+    server.start();
+
+    std::vector<UnixSocket> clients(32);
+    for (auto& client : clients)
+    {
+        ASSERT_TRUE(client.connect(path, false, ec)) << ec.message();
+    }
+    for (int i = 0; i < 10 && server.getClientCount() < clients.size(); ++i)
+    {
+        server.step();
+    }
+    ASSERT_EQ(server.getClientCount(), clients.size());
+    EXPECT_EQ(server.getBufferPool().lentBuffers(), 0u);
+
+    auto request = PackTexts({"ping"});
+    ASSERT_EQ(clients[3].send(request.data(), request.size(), ec), static_cast<ssize_t>(request.size()));
+    server.step();
+
+    std::vector<uint8_t> reply(request.size());
+    ASSERT_EQ(clients[3].recv(reply.data(), reply.size(), ec), static_cast<ssize_t>(reply.size()));
+    EXPECT_EQ(reply, request);
+    EXPECT_EQ(server.getBufferPool().lentBuffers(), 0u);
+    EXPECT_EQ(server.getBufferPool().cachedBuffers(), 2u);
+    server.stop();
+}
+
+TEST(GenericServerBufferTest, MemoryLimitPausesReads)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServerConfig config;
+    config.bufferMemoryLimit = 2 * config.byteBufferSize;
+    GenericServer<UnixSocket> server(config);
+    server.setConnectionHandler(
+        [](Context<UnixSocket>& ctx)
+        {
+            std::error_code ec;
+            ctx.readThenUnpackAll<TextMessage>([&](const TextMessage& message) { ctx.packThenSend(message, ec); },
+                                               ec);
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 16, ec)) << ec.message();
+    server.start();
+
+    UnixSocket slow;
+    UnixSocket fast;
+    ASSERT_TRUE(slow.connect(path, false, ec)) << ec.message();
+    ASSERT_TRUE(fast.connect(path, false, ec)) << ec.message();
+    for (int i = 0; i < 10 && server.getClientCount() < 2; ++i)
+    {
+        server.step();
+    }
+
+    // The partial message keeps a read buffer lent, the other client cannot get two buffers.
+    auto slowRequest = PackTexts({"slow"});
+    ASSERT_EQ(slow.send(slowRequest.data(), 3, ec), 3);
+    server.step();
+    EXPECT_EQ(server.getBufferPool().lentBuffers(), 1u);
+
+    auto fastRequest = PackTexts({"fast"});
+    ASSERT_EQ(fast.send(fastRequest.data(), fastRequest.size(), ec), static_cast<ssize_t>(fastRequest.size()));
+    server.step();
+    server.step();
+
+    std::vector<uint8_t> reply(fastRequest.size());
+    EXPECT_EQ(::recv(fast.getFd(), reply.data(), reply.size(), MSG_DONTWAIT), -1);
+
+    ASSERT_EQ(slow.send(slowRequest.data() + 3, slowRequest.size() - 3, ec),
+              static_cast<ssize_t>(slowRequest.size() - 3));
+    for (int i = 0; i < 4; ++i)
+    {
+        server.step();
+    }
+
+    ASSERT_EQ(fast.recv(reply.data(), reply.size(), ec), static_cast<ssize_t>(reply.size()));
+    EXPECT_EQ(reply, fastRequest);
+    reply.resize(slowRequest.size());
+    ASSERT_EQ(slow.recv(reply.data(), reply.size(), ec), static_cast<ssize_t>(reply.size()));
+    EXPECT_EQ(reply, slowRequest);
+    EXPECT_EQ(server.getBufferPool().lentBuffers(), 0u);
+    server.stop();
+}
+
+TEST(GenericServerBufferTest, MemoryLimitKeepsTwoBuffers)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServerConfig config;
+    config.bufferMemoryLimit = config.byteBufferSize;
+    GenericServer<UnixSocket> server(config);
+    server.setConnectionHandler(
+        [](Context<UnixSocket>& ctx)
+        {
+            std::error_code ec;
+            ctx.readThenUnpackAll<TextMessage>([&](const TextMessage& message) { ctx.packThenSend(message, ec); },
+                                               ec);
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 16, ec)) << ec.message();
+    server.start();
+
+    UnixSocket client;
+    ASSERT_TRUE(client.connect(path, false, ec)) << ec.message();
+    auto request = PackTexts({"ping"});
+    ASSERT_EQ(client.send(request.data(), request.size(), ec), static_cast<ssize_t>(request.size()));
+    for (int i = 0; i < 4; ++i)
+    {
+        server.step();
+    }
+
+    std::vector<uint8_t> reply(request.size());
+    ASSERT_EQ(client.recv(reply.data(), reply.size(), ec), static_cast<ssize_t>(reply.size()));
+    EXPECT_EQ(reply, request);
+    server.stop();
+}
+
+TEST(GenericServerBufferTest, MemoryLimitCountsGrowth)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServerConfig config;
+    config.bufferMemoryLimit = 3 * config.byteBufferSize;
+    GenericServer<UnixSocket> server(config);
+    server.setConnectionHandler(
+        [](Context<UnixSocket>& ctx)
+        {
+            std::error_code ec;
+            ctx.readThenUnpackAll<TextMessage>([&](const TextMessage& message) { ctx.packThenSend(message, ec); },
+                                               ec);
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 16, ec)) << ec.message();
+    server.start();
+
+    UnixSocket slow;
+    UnixSocket fast;
+    ASSERT_TRUE(slow.connect(path, false, ec)) << ec.message();
+    ASSERT_TRUE(fast.connect(path, false, ec)) << ec.message();
+    for (int i = 0; i < 10 && server.getClientCount() < 2; ++i)
+    {
+        server.step();
+    }
+
+    // One lent buffer leaves room for two more, the read buffer growing past its pooled size takes it.
+    std::vector<uint8_t> slowRequest(3 * config.byteBufferSize);
+    Packer packer(slowRequest.data(), slowRequest.size());
+    packer.pack(std::string(2 * config.byteBufferSize, 'x'));
+    slowRequest.resize(packer.position());
+    size_t split = config.byteBufferSize + 100;
+    ASSERT_EQ(slow.send(slowRequest.data(), split, ec), static_cast<ssize_t>(split));
+    server.step();
+    EXPECT_EQ(server.getBufferPool().lentBuffers(), 1u);
+    EXPECT_GT(server.getBufferPool().memoryUsage(), 2 * config.byteBufferSize);
+
+    auto fastRequest = PackTexts({"fast"});
+    ASSERT_EQ(fast.send(fastRequest.data(), fastRequest.size(), ec), static_cast<ssize_t>(fastRequest.size()));
+    server.step();
+    server.step();
+
+    std::vector<uint8_t> reply(fastRequest.size());
+    EXPECT_EQ(::recv(fast.getFd(), reply.data(), reply.size(), MSG_DONTWAIT), -1);
+
+    ASSERT_EQ(slow.send(slowRequest.data() + split, slowRequest.size() - split, ec),
+              static_cast<ssize_t>(slowRequest.size() - split));
+    std::vector<uint8_t> slowReply(slowRequest.size());
+    size_t received = 0;
+    for (int i = 0; i < 20 && received < slowReply.size(); ++i)
+    {
+        server.step();
+        ssize_t n = ::recv(slow.getFd(), slowReply.data() + received, slowReply.size() - received, MSG_DONTWAIT);
+        received += n > 0 ? static_cast<size_t>(n) : 0;
+    }
+    server.step();
+
+    ASSERT_EQ(received, slowReply.size());
+    EXPECT_EQ(slowReply, slowRequest);
+    ASSERT_EQ(::recv(fast.getFd(), reply.data(), reply.size(), MSG_DONTWAIT), static_cast<ssize_t>(reply.size()));
+    EXPECT_EQ(reply, fastRequest);
+    EXPECT_EQ(server.getBufferPool().lentBuffers(), 0u);
+    EXPECT_EQ(server.getBufferPool().memoryUsage(), server.getBufferPool().cachedBuffers() * config.byteBufferSize);
+    server.stop();
+}
+
+class GenericServerCompletionTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!IoUringPoller::isSupported() || !IoUringPoller::isRecvMultishotSupported())
+        {
+            GTEST_SKIP() << "io_uring multishot recv is not available";
+        }
+    }
+
+    static GenericServerConfig CompletionConfig()
+    {
+        GenericServerConfig config;
+        config.pollerBackend = PollerBackend::IoUring;
+        config.completionIo = true;
+        return config;
+    }
+};
+
+TEST_F(GenericServerCompletionTest, EchoesAndClosesOnEof)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServerConfig config = CompletionConfig();
+    config.byteBufferSize = 64;
+    GenericServer<UnixSocket> server(config);
+    bool completionRecv = false;
+    server.setConnectionHandler(
+        [&](Context<UnixSocket>& ctx)
+        {
+            completionRecv = ctx.completionRecv;
+            std::error_code ec;
+            ctx.readThenUnpackAll<TextMessage>([&](const TextMessage& message) { ctx.packThenSend(message, ec); },
+                                               ec);
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 16, ec)) << ec.message();
+    server.start();
+
+    UnixSocket client;
+    ASSERT_TRUE(client.connect(path, false, ec)) << ec.message();
+
+    // Larger than one provided buffer, so the frame arrives in several completions.
+    auto request = PackTexts({"one", std::string(150, 'x'), "three"});
+    ASSERT_EQ(client.send(request.data(), request.size(), ec), static_cast<ssize_t>(request.size()));
+    for (int i = 0; i < 20 && server.getStatistics().totalBytesSent.load() < request.size(); ++i)
+    {
+        server.step();
+    }
+
+    EXPECT_TRUE(completionRecv);
+    std::vector<uint8_t> reply(request.size());
+    size_t received = 0;
+    while (received < reply.size())
+    {
+        ssize_t n = client.recv(reply.data() + received, reply.size() - received, ec);
+        ASSERT_GT(n, 0) << ec.message();
+        received += static_cast<size_t>(n);
+    }
+    EXPECT_EQ(reply, request);
+    ASSERT_EQ(server.getClientCount(), 1u);
+
+    client.close();
+    for (int i = 0; i < 20 && server.getClientCount() > 0; ++i)
+    {
+        server.step();
+    }
+    EXPECT_EQ(server.getClientCount(), 0u);
+    server.stop();
+}
+
+TEST_F(GenericServerCompletionTest, ClosesClientWhenFrameExceedsBufferLimit)
+{
+    const char* path = "/tmp/casket_generic_server_test.sock";
+
+    GenericServerConfig config = CompletionConfig();
+    config.byteBufferSize = 64;
+    config.maxReadBufferSize = 256;
+    GenericServer<UnixSocket> server(config);
+    size_t received = 0;
+    server.setConnectionHandler(
+        [&](Context<UnixSocket>& ctx)
+        {
+            std::error_code ec;
+            received += ctx.readThenUnpackAll<TextMessage>([](const TextMessage&) {}, ec);
+        });
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen(path, -1, 16, ec)) << ec.message();
+    server.start();
+
+    UnixSocket client;
+    ASSERT_TRUE(client.connect(path, false, ec)) << ec.message();
+    for (int i = 0; i < 20 && server.getClientCount() == 0; ++i)
+    {
+        server.step();
+    }
+
+    // The second frame never completes, its bytes pile up past the limit.
+    auto bytes = PackTexts({"small", std::string(1000, 'b')});
+    ASSERT_EQ(client.send(bytes.data(), bytes.size() - 10, ec), static_cast<ssize_t>(bytes.size() - 10));
+    for (int i = 0; i < 20 && server.getClientCount() > 0; ++i)
+    {
+        server.step();
+    }
+
+    EXPECT_EQ(received, 1u);
+    EXPECT_EQ(server.getClientCount(), 0u);
+    uint8_t byte;
+    EXPECT_EQ(client.recv(&byte, 1, ec), 0);
+    server.stop();
+}
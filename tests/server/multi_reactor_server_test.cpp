@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <casket/server/multi_reactor_server.hpp>
+
+#include "common/server_test_utils.hpp"
+
+using namespace casket;
+using namespace casket::test;
+
+TEST(MultiReactorServerTest, ServesClientsOnAllReactors)
+{
+    MultiReactorServer<TcpSocket> server(2);
+    server.setConnectionHandler(EchoHandler<TcpSocket>);
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen("127.0.0.1", 0, 128, ec)) << ec.message();
+    ASSERT_GT(server.getPort(), 0);
+    server.start();
+
+    // SO_REUSEPORT hashes the 4-tuple, with 64 connections both reactors get some with near certainty.
+    std::vector<TcpSocket> clients(64);
+    for (size_t i = 0; i < clients.size(); ++i)
+    {
+        ASSERT_TRUE(clients[i].connect("127.0.0.1", static_cast<uint16_t>(server.getPort()), false, ec))
+            << ec.message();
+        std::string message = "ping-" + std::to_string(i);
+        EXPECT_EQ(Exchange(clients[i], message), message);
+    }
+
+    ServerStatistics total;
+    server.aggregateStatistics(total);
+    EXPECT_EQ(total.totalConnections.load(), clients.size());
+    EXPECT_EQ(total.activeConnections.load(), clients.size());
+
+    EXPECT_GT(server.getReactor(0).getStatistics().totalConnections.load(), 0u);
+    EXPECT_GT(server.getReactor(1).getStatistics().totalConnections.load(), 0u);
+
+    server.stop();
+    EXPECT_FALSE(server.isRunning());
+}
+
+TEST(MultiReactorServerTest, GracefulStopDrainsConnections)
+{
+    MultiReactorServer<TcpSocket> server(2);
+    server.setConnectionHandler(EchoHandler<TcpSocket>);
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen("127.0.0.1", 0, 128, ec)) << ec.message();
+    auto port = static_cast<uint16_t>(server.getPort());
+    server.start();
+
+    TcpSocket client;
+    ASSERT_TRUE(client.connect("127.0.0.1", port, false, ec)) << ec.message();
+    ASSERT_EQ(Exchange(client, "before"), "before");
+
+    auto started = std::chrono::steady_clock::now();
+    auto stopped = std::async(std::launch::async, [&server]() { server.stop(std::chrono::seconds(5)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    EXPECT_EQ(Exchange(client, "during"), "during");
+
+    TcpSocket late;
+    EXPECT_FALSE(late.connect("127.0.0.1", port, false, ec));
+    EXPECT_EQ(stopped.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+
+    client.close();
+    stopped.wait();
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(3));
+}
+
+TEST(MultiReactorServerTest, DrainTimeoutClosesRemainingClients)
+{
+    MultiReactorServer<TcpSocket> server(1);
+    server.setConnectionHandler(EchoHandler<TcpSocket>);
+
+    std::error_code ec;
+    ASSERT_TRUE(server.listen("127.0.0.1", 0, 128, ec)) << ec.message();
+    server.start();
+
+    TcpSocket client;
+    ASSERT_TRUE(client.connect("127.0.0.1", static_cast<uint16_t>(server.getPort()), false, ec));
+    ASSERT_EQ(Exchange(client, "x"), "x");
+
+    auto started = std::chrono::steady_clock::now();
+    server.stop(std::chrono::milliseconds(200));
+    auto elapsed = std::chrono::steady_clock::now() - started;
+    EXPECT_GE(elapsed, std::chrono::milliseconds(200));
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+
+    uint8_t byte;
+    EXPECT_EQ(client.recv(&byte, 1, ec), 0);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <casket/thread/placement.hpp>
+
+using namespace casket::thread;
+
+TEST(ThreadPlacementTest, ParseCpuList)
+{
+    ASSERT_EQ(ParseCpuList("0"), (std::vector<int>{0}));
+    ASSERT_EQ(ParseCpuList("0-3,8,10-11\n"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    ASSERT_TRUE(ParseCpuList("").empty());
+}
+
+TEST(ThreadPlacementTest, EmptyPlacement)
+{
+    ThreadPlacement placement;
+    ASSERT_TRUE(placement.empty());
+
+    placement.name = "worker";
+    ASSERT_FALSE(placement.empty());
+}
+
+TEST(ThreadPlacementTest, ApplyNameAndAffinity)
+{
+    ThreadPlacement placement;
+    placement.name = "a-very-long-thread-name";
+    placement.cpuSets = {{0}};
+
+    std::error_code ec;
+    std::string name;
+    int cpu = -1;
+
+    std::thread worker(
+        [&]
+        {
+            ApplyThreadPlacement(placement, 7, ec);
+
+            char buffer[16] = {};
+            pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+            name = buffer;
+            cpu = sched_getcpu();
+        });
+    worker.join();
+
+    ASSERT_FALSE(ec) << ec.message();
+    ASSERT_EQ(name, "a-very-long-thr");
+    ASSERT_EQ(cpu, 0);
+}
+
+TEST(ThreadPlacementTest, InvalidCpu)
+{
+    std::error_code ec;
+    std::thread worker([&] { SetCurrentThreadAffinity({-1}, ec); });
+    worker.join();
+
+    ASSERT_EQ(ec, std::errc::invalid_argument);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <casket/thread/priority_task_queue.hpp>
+
+using namespace casket::thread;
+using namespace std::chrono_literals;
+
+TEST(PriorityTaskQueueTest, HigherClassFirst)
+{
+    PriorityTaskQueue queue;
+    std::vector<int> order;
+
+    queue.push([&] { order.push_back(3); }, TaskPriority::Low);
+    queue.push([&] { order.push_back(2); }, TaskPriority::Normal);
+    queue.push([&] { order.push_back(1); }, TaskPriority::High);
+
+    while (!queue.empty())
+    {
+        queue.pop()();
+    }
+
+    ASSERT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(PriorityTaskQueueTest, FifoWithinClass)
+{
+    PriorityTaskQueue queue;
+    std::vector<int> order;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        queue.push([&order, i] { order.push_back(i); }, TaskPriority::Normal);
+    }
+
+    while (!queue.empty())
+    {
+        queue.pop()();
+    }
+
+    ASSERT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(PriorityTaskQueueTest, EarliestDeadlineFirst)
+{
+    PriorityTaskQueue queue;
+    std::vector<int> order;
+    auto now = TaskClock::now();
+
+    queue.push([&] { order.push_back(0); }, TaskPriority::Normal);
+    queue.push([&] { order.push_back(30); }, TaskPriority::Normal, now + 30ms, now);
+    queue.push([&] { order.push_back(10); }, TaskPriority::Normal, now + 10ms, now);
+    queue.push([&] { order.push_back(20); }, TaskPriority::Normal, now + 20ms, now);
+
+    while (!queue.empty())
+    {
+        queue.pop(now)();
+    }
+
+    ASSERT_EQ(order, (std::vector<int>{10, 20, 30, 0}));
+}
+
+TEST(PriorityTaskQueueTest, StarvationProtection)
+{
+    PriorityTaskQueue queue({0us, 0us, 50ms});
+    std::vector<int> order;
+    auto now = TaskClock::now();
+
+    queue.push([&] { order.push_back(3); }, TaskPriority::Low, TaskClock::time_point::max(), now);
+    queue.push([&] { order.push_back(1); }, TaskPriority::High, TaskClock::time_point::max(), now);
+
+    queue.pop(now + 100ms)();
+    queue.pop(now + 100ms)();
+
+    ASSERT_EQ(order, (std::vector<int>{3, 1}));
+    ASSERT_EQ(queue.getStatistics(TaskPriority::Low).promoted.load(), 1u);
+}
+
+TEST(PriorityTaskQueueTest, StarvationPromotesOldestTask)
+{
+    PriorityTaskQueue queue({0us, 0us, 50ms});
+    std::vector<int> order;
+    auto now = TaskClock::now();
+
+    // Fresh deadline tasks stay ahead of the no-deadline one within the class, its own wait must trigger promotion.
+    queue.push([&] { order.push_back(0); }, TaskPriority::Low, TaskClock::time_point::max(), now);
+    queue.push([&] { order.push_back(1); }, TaskPriority::High, TaskClock::time_point::max(), now + 90ms);
+    queue.push([&] { order.push_back(2); }, TaskPriority::Low, now + 200ms, now + 90ms);
+    queue.push([&] { order.push_back(3); }, TaskPriority::Low, now + 210ms, now + 90ms);
+
+    queue.pop(now + 100ms)();
+    ASSERT_EQ(order, (std::vector<int>{0}));
+    ASSERT_EQ(queue.getStatistics(TaskPriority::Low).promoted.load(), 1u);
+
+    while (!queue.empty())
+    {
+        queue.pop(now + 100ms)();
+    }
+
+    ASSERT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+    ASSERT_EQ(queue.getStatistics(TaskPriority::Low).promoted.load(), 1u);
+}
+
+TEST(PriorityTaskQueueTest, OldestTrackedAcrossOutOfOrderDispatch)
+{
+    PriorityTaskQueue queue({0us, 0us, 50ms});
+    std::vector<int> order;
+    auto now = TaskClock::now();
+
+    queue.push([&] { order.push_back(0); }, TaskPriority::Low, TaskClock::time_point::max(), now);
+    queue.push([&] { order.push_back(1); }, TaskPriority::Low, now + 10ms, now + 40ms);
+    queue.push([&] { order.push_back(2); }, TaskPriority::Low, TaskClock::time_point::max(), now + 40ms);
+
+    // The deadline task leaves first, the no-deadline task queued before it stays the oldest.
+    queue.pop(now + 45ms)();
+    queue.push([&] { order.push_back(9); }, TaskPriority::High, TaskClock::time_point::max(), now + 60ms);
+    queue.pop(now + 60ms)();
+    queue.pop(now + 60ms)();
+
+    ASSERT_EQ(order, (std::vector<int>{1, 0, 9}));
+    ASSERT_EQ(queue.getStatistics(TaskPriority::Low).promoted.load(), 1u);
+
+    // Task 2 has waited only 20ms, the High task goes first.
+    queue.push([&] { order.push_back(8); }, TaskPriority::High, TaskClock::time_point::max(), now + 60ms);
+    queue.pop(now + 60ms)();
+    queue.pop(now + 60ms)();
+    ASSERT_EQ(order, (std::vector<int>{1, 0, 9, 8, 2}));
+}
+
+TEST(PriorityTaskQueueTest, Statistics)
+{
+    PriorityTaskQueue queue;
+    auto now = TaskClock::now();
+
+    queue.push([] {}, TaskPriority::High, now + 1ms, now);
+    queue.push([] {}, TaskPriority::High, now + 1ms, now);
+    queue.pop(now + 5ms);
+
+    const auto& stats = queue.getStatistics(TaskPriority::High);
+    ASSERT_EQ(stats.submitted.load(), 2u);
+    ASSERT_EQ(stats.dispatched.load(), 1u);
+    ASSERT_EQ(stats.deadlineMissed.load(), 1u);
+    ASSERT_EQ(stats.queueDepth.max(), 2u);
+    ASSERT_EQ(stats.waitTimeUs.max(), 5000u);
+    ASSERT_EQ(queue.size(TaskPriority::High), 1u);
+    ASSERT_EQ(queue.clear(), 1u);
+    ASSERT_TRUE(queue.empty());
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <chrono>
 #include <atomic>
+#include <vector>
+#include <mutex>
 #include <casket/thread/pool.hpp>
 
 using namespace casket::thread;
@@ -133,4 +135,235 @@ TEST(ThreadPoolTest, ConcurrentExecution)
     }
 
     ASSERT_EQ(counter.load(), numTasks);
-}
\ No newline at end of file
+}
+TEST(ThreadPoolTest, PriorityOrder)
+{
+    ThreadPool pool(1);
+    std::mutex mutex;
+    std::vector<int> order;
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+
+    pool.add([opened] { opened.wait(); });
+
+    auto record = [&](int value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(value);
+    };
+
+    auto low = pool.addWithPriority(TaskPriority::Low, record, 3);
+    auto normal = pool.add(record, 2);
+    auto high = pool.addWithPriority(TaskPriority::High, record, 1);
+
+    gate.set_value();
+    low.get();
+    normal.get();
+    high.get();
+
+    ASSERT_EQ(order, (std::vector<int>{1, 2, 3}));
+    ASSERT_EQ(pool.getStatistics(TaskPriority::High).dispatched.load(), 1u);
+    ASSERT_EQ(pool.getStatistics(TaskPriority::Low).dispatched.load(), 1u);
+}
+
+TEST(ThreadPoolTest, DeadlineOrder)
+{
+    ThreadPool pool(1);
+    std::vector<int> order;
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    auto now = TaskClock::now();
+
+    pool.addWithPriority(TaskPriority::High, [opened] { opened.wait(); });
+
+    auto late = pool.addWithDeadline(TaskPriority::High, now + 2s, [&] { order.push_back(2); });
+    auto early = pool.addWithDeadline(TaskPriority::High, now + 1s, [&] { order.push_back(1); });
+
+    gate.set_value();
+    late.get();
+    early.get();
+
+    ASSERT_EQ(order, (std::vector<int>{1, 2}));
+}
+
+TEST(ThreadPoolTest, LowPriorityIsNotStarved)
+{
+    ThreadPoolConfig config;
+    config.threads = 1;
+    config.maxWait = {0us, 0us, 20ms};
+
+    // Declared before the pool, ~ThreadPool() still runs queued copies of busy that read them.
+    std::atomic<bool> lowDone{false};
+    std::atomic<bool> stop{false};
+    std::function<void()> busy;
+
+    ThreadPool pool(config);
+    pool.addWithPriority(TaskPriority::Low, [&] { lowDone = true; });
+
+    busy = [&]
+    {
+        std::this_thread::sleep_for(1ms);
+        if (!stop)
+        {
+            pool.addTask(busy, TaskPriority::High);
+        }
+    };
+    pool.addTask(busy, TaskPriority::High);
+
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (!lowDone && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(5ms);
+    }
+    stop = true;
+
+    ASSERT_TRUE(lowDone.load());
+}
+
+TEST(ThreadPoolTest, ShutdownDrainRunsQueuedTasks)
+{
+    ThreadPool pool(1);
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 20; ++i)
+    {
+        pool.addTask(
+            [&counter]
+            {
+                std::this_thread::sleep_for(1ms);
+                ++counter;
+            });
+    }
+
+    pool.shutdown(ShutdownMode::Drain);
+    ASSERT_FALSE(pool.addTask([&counter] { ++counter; }));
+
+    pool.join();
+    ASSERT_EQ(counter.load(), 20);
+}
+
+TEST(ThreadPoolTest, ShutdownCancelDropsQueuedTasks)
+{
+    ThreadPool pool(1);
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    auto token = pool.getCancellationToken();
+
+    auto blocker = pool.add([opened] { opened.wait(); });
+    auto dropped = pool.add([] { return 1; });
+
+    while (pool.active() == 0)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    ASSERT_FALSE(token.isCancelled());
+    pool.shutdown(ShutdownMode::Cancel);
+    ASSERT_TRUE(token.isCancelled());
+    ASSERT_EQ(pool.pending(), 0u);
+
+    gate.set_value();
+    pool.join();
+
+    blocker.get();
+    ASSERT_THROW(dropped.get(), std::future_error);
+}
+
+TEST(ThreadPoolTest, CancellationTokenStopsLongTask)
+{
+    ThreadPool pool(2);
+    auto token = pool.getCancellationToken();
+    std::atomic<bool> started{false};
+
+    auto result = pool.add(
+        [token, &started]
+        {
+            started = true;
+            int iterations = 0;
+            while (!token.isCancelled())
+            {
+                std::this_thread::sleep_for(1ms);
+                ++iterations;
+            }
+            return iterations;
+        });
+
+    while (!started)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    pool.shutdown(ShutdownMode::Cancel);
+    ASSERT_TRUE(pool.join(2s));
+    ASSERT_GE(result.get(), 0);
+}
+
+TEST(ThreadPoolTest, WaitIdle)
+{
+    ThreadPool pool(2);
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 50; ++i)
+    {
+        pool.addTask([&counter] { ++counter; });
+    }
+
+    pool.waitIdle();
+    ASSERT_EQ(counter.load(), 50);
+    ASSERT_EQ(pool.pending(), 0u);
+    ASSERT_EQ(pool.active(), 0u);
+    ASSERT_TRUE(pool.waitIdle(10ms));
+}
+
+TEST(ThreadPoolTest, TimedJoin)
+{
+    ThreadPool pool(1);
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+
+    pool.add([opened] { opened.wait(); });
+
+    ASSERT_FALSE(pool.join(50ms));
+    ASSERT_TRUE(pool.isShutdown());
+
+    gate.set_value();
+    ASSERT_TRUE(pool.join(2s));
+}
+
+TEST(CancellationTest, DefaultTokenIsNeverCancelled)
+{
+    CancellationToken token;
+    ASSERT_FALSE(token.isCancelled());
+
+    CancellationSource source;
+    auto sourceToken = source.token();
+    ASSERT_FALSE(sourceToken.isCancelled());
+
+    source.cancel();
+    ASSERT_TRUE(source.isCancelled());
+    ASSERT_TRUE(sourceToken.isCancelled());
+}
+
+TEST(ThreadPoolTest, WorkerPlacement)
+{
+    ThreadPoolConfig config;
+    config.threads = 2;
+    config.placement.name = "casket-worker";
+    config.placement.cpuSets = {{0}};
+    ThreadPool pool(config);
+
+    auto result = pool.add(
+        []
+        {
+            char name[16] = {};
+            pthread_getname_np(pthread_self(), name, sizeof(name));
+            return std::make_pair(std::string(name), sched_getcpu());
+        });
+
+    auto [name, cpu] = result.get();
+    ASSERT_EQ(name.rfind("casket-worker-", 0), 0u);
+    ASSERT_EQ(cpu, 0);
+
+    pool.waitIdle();
+    ASSERT_FALSE(pool.getPlacementError());
+}
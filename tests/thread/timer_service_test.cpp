@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <casket/thread/timer_service.hpp>
+
+using namespace casket::thread;
+using namespace std::chrono;
+
+TEST(TimerServiceTest, RunsDelayedCallback)
+{
+    TimerService service;
+    std::promise<steady_clock::time_point> fired;
+    auto start = steady_clock::now();
+
+    service.scheduleAfter(milliseconds(50), [&fired] { fired.set_value(steady_clock::now()); });
+
+    auto future = fired.get_future();
+    ASSERT_EQ(future.wait_for(seconds(5)), std::future_status::ready);
+    EXPECT_GE(future.get() - start, milliseconds(50));
+}
+
+TEST(TimerServiceTest, CancelledCallbackDoesNotRun)
+{
+    TimerService service;
+    std::atomic<int> fired{0};
+
+    auto handle = service.scheduleAfter(milliseconds(50), [&fired] { ++fired; });
+    EXPECT_TRUE(service.cancel(handle));
+    EXPECT_EQ(service.size(), 0U);
+
+    std::this_thread::sleep_for(milliseconds(100));
+    EXPECT_EQ(fired.load(), 0);
+}
+
+TEST(TimerServiceTest, CallbackCanScheduleTimers)
+{
+    TimerService service;
+    std::promise<void> done;
+
+    service.scheduleAfter(milliseconds(5),
+                          [&service, &done]
+                          { service.scheduleAfter(milliseconds(5), [&done] { done.set_value(); }); });
+
+    EXPECT_EQ(done.get_future().wait_for(seconds(5)), std::future_status::ready);
+}
+
+TEST(TimerServiceTest, StopDropsPendingTimers)
+{
+    std::atomic<int> fired{0};
+    {
+        TimerService service;
+        service.scheduleAfter(seconds(60), [&fired] { ++fired; });
+        service.stop();
+    }
+    EXPECT_EQ(fired.load(), 0);
+}
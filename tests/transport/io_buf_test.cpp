@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <casket/transport/byte_buffer.hpp>
+#include <casket/transport/io_buf.hpp>
+#include <casket/transport/unix_socket.hpp>
+
+using namespace casket;
+
+namespace
+{
+
+struct TextMessage
+{
+    nonstd::string_view text;
+
+    PackResult<Packer*> pack(Packer& packer) const
+    {
+        return packer.pack(text);
+    }
+
+    static UnpackResult<TextMessage> unpack(Unpacker& unpacker)
+    {
+        auto result = unpacker.unpackString();
+        if (!result)
+        {
+            return UnpackResult<TextMessage>(result.error());
+        }
+        return TextMessage{result.value()};
+    }
+};
+
+std::string ToString(const IOBuf& buf)
+{
+    std::string out(buf.size(), '\0');
+    EXPECT_EQ(buf.copyTo(out.data(), out.size()), out.size());
+    return out;
+}
+
+std::string Pattern(size_t size)
+{
+    std::string out(size, '\0');
+    for (size_t i = 0; i < size; ++i)
+    {
+        out[i] = static_cast<char>('a' + i % 26);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(IOBufTest, AppendChainsBlocks)
+{
+    IOBufPool pool(64);
+    {
+        IOBuf buf(pool);
+        auto data = Pattern(1000);
+        buf.append(data.data(), data.size());
+
+        EXPECT_EQ(buf.size(), 1000u);
+        EXPECT_EQ(buf.segmentCount(), 16u);
+        EXPECT_EQ(ToString(buf), data);
+
+        buf.consume(130);
+        EXPECT_EQ(buf.segmentCount(), 14u);
+        EXPECT_EQ(ToString(buf), data.substr(130));
+        EXPECT_EQ(pool.outstandingBlocks(), 14u);
+    }
+    EXPECT_EQ(pool.outstandingBlocks(), 0u);
+    EXPECT_EQ(pool.cachedBlocks(), 16u);
+}
+
+TEST(IOBufTest, SplitAndAppendShareBlocks)
+{
+    IOBufPool pool(64);
+    IOBuf buf(pool);
+    auto data = Pattern(200);
+    buf.append(data.data(), data.size());
+    size_t blocks = pool.outstandingBlocks();
+
+    IOBuf head = buf.split(100);
+    EXPECT_EQ(ToString(head), data.substr(0, 100));
+    EXPECT_EQ(ToString(buf), data.substr(100));
+    EXPECT_EQ(pool.outstandingBlocks(), blocks);
+
+    IOBuf joined(pool);
+    joined.append(std::move(head));
+    joined.append(buf);
+    EXPECT_TRUE(head.empty());
+    EXPECT_EQ(ToString(joined), data);
+    EXPECT_EQ(pool.outstandingBlocks(), blocks);
+}
+
+TEST(IOBufTest, CopiesDivergeOnAppend)
+{
+    IOBufPool pool(64);
+    IOBuf first(pool);
+    first.append("abc", 3);
+
+    IOBuf second(first);
+    first.append("X", 1);
+    second.append("Y", 1);
+
+    EXPECT_EQ(ToString(first), "abcX");
+    EXPECT_EQ(ToString(second), "abcY");
+}
+
+TEST(IOBufTest, PacksAndUnpacksAcrossBlocks)
+{
+    IOBufPool pool(16);
+    IOBuf buf(pool);
+    std::vector<std::string> texts = {"one", Pattern(10), Pattern(100), "two", Pattern(40)};
+    for (const auto& text : texts)
+    {
+        ASSERT_TRUE(buf.pack(TextMessage{text}));
+    }
+    EXPECT_GT(buf.segmentCount(), 1u);
+
+    IOBuf tail = buf;
+    IOBuf partial = tail.split(tail.size() - 5);
+
+    for (const auto& text : texts)
+    {
+        size_t length;
+        auto result = buf.unpackFront<TextMessage>(length);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(std::string(result->text.data(), result->text.size()), text);
+        buf.consume(length);
+    }
+    EXPECT_TRUE(buf.empty());
+
+    for (size_t i = 0; i + 1 < texts.size(); ++i)
+    {
+        size_t length;
+        ASSERT_TRUE(partial.unpackFront<TextMessage>(length));
+        partial.consume(length);
+    }
+    size_t length;
+    auto result = partial.unpackFront<TextMessage>(length);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), UnpackerError::PrematureEnd);
+    EXPECT_EQ(length, 0u);
+
+    partial.append(std::move(tail));
+    ASSERT_TRUE(partial.unpackFront<TextMessage>(length));
+    partial.consume(length);
+    EXPECT_TRUE(partial.empty());
+}
+
+TEST(IOBufTest, ScatterGatherThroughSocket)
+{
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+    UnixSocket writer = UnixSocket::adopt(fds[0], true);
+    UnixSocket reader = UnixSocket::adopt(fds[1], true);
+
+    IOBufPool pool(256);
+    IOBuf out(pool);
+    IOBuf in(pool);
+    auto data = Pattern(20000);
+    out.append(data.data(), data.size());
+
+    std::error_code ec;
+    while (!out.empty() || in.size() < data.size())
+    {
+        ssize_t sent = out.sendTo(writer, ec);
+        ASSERT_GE(sent, 0) << ec.message();
+        ssize_t received = in.recvFrom(reader, ec);
+        ASSERT_GE(received, 0) << ec.message();
+        ASSERT_TRUE(sent > 0 || received > 0);
+    }
+    EXPECT_EQ(ToString(in), data);
+
+    in.clear();
+    EXPECT_EQ(pool.outstandingBlocks(), 0u);
+}
+
+TEST(IOBufBenchmark, LargeMessageAccumulation)
+{
+    constexpr size_t kMessage = 8 << 20;
+    constexpr size_t kRead = 1024;
+    std::vector<uint8_t> chunk(kRead, 'x');
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    ByteBuffer flat(4096);
+    for (size_t total = 0; total < kMessage; total += kRead)
+    {
+        if (flat.availableWrite() < kRead)
+        {
+            flat.expand(flat.capacity() * 2);
+        }
+        std::memcpy(flat.getWritePtr(), chunk.data(), kRead);
+        flat.commitWrite(kRead);
+    }
+    auto flatTime = Clock::now() - start;
+
+    start = Clock::now();
+    IOBufPool pool;
+    IOBuf chain(pool);
+    for (size_t total = 0; total < kMessage; total += kRead)
+    {
+        chain.append(chunk.data(), kRead);
+    }
+    auto chainTime = Clock::now() - start;
+
+    EXPECT_EQ(flat.availableRead(), chain.size());
+    using Ms = std::chrono::duration<double, std::milli>;
+    std::printf("[ IOBuf    ] %zu MiB in %zu byte reads: ByteBuffer %.2f ms, IOBuf %.2f ms\n", kMessage >> 20, kRead,
+                Ms(flatTime).count(), Ms(chainTime).count());
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <casket/pack/pack.hpp>
+#include <casket/transport/buffer_pool.hpp>
+#include <casket/transport/byte_buffer.hpp>
+#include <casket/transport/mirrored_ring_buffer.hpp>
+#include <casket/transport/unix_socket.hpp>
+
+using namespace casket;
+
+namespace
+{
+
+void Write(MirroredRingBuffer& buffer, const std::string& data)
+{
+    ASSERT_GE(buffer.availableWrite(), data.size());
+    std::memcpy(buffer.getWritePtr(), data.data(), data.size());
+    buffer.commitWrite(data.size());
+}
+
+std::string Read(MirroredRingBuffer& buffer, size_t size)
+{
+    std::string out(reinterpret_cast<const char*>(buffer.getReadPtr()), size);
+    buffer.commitRead(size);
+    return out;
+}
+
+template <typename Buffer>
+size_t RunPartialReads(Buffer& buffer, size_t totalBytes, size_t readSize, size_t messageSize)
+{
+    std::vector<uint8_t> chunk(readSize, 'x');
+    size_t messages = 0;
+    for (size_t produced = 0; produced < totalBytes;)
+    {
+        size_t count = std::min(readSize, buffer.availableWrite());
+        std::memcpy(buffer.getWritePtr(), chunk.data(), count);
+        buffer.commitWrite(count);
+        produced += count;
+
+        while (buffer.availableRead() >= messageSize)
+        {
+            messages += buffer.getReadPtr()[messageSize - 1] == 'x';
+            buffer.commitRead(messageSize);
+        }
+    }
+    return messages;
+}
+
+} // namespace
+
+TEST(MirroredRingBufferTest, CapacityIsRoundedToPages)
+{
+    MirroredRingBuffer buffer(100);
+    EXPECT_EQ(buffer.capacity(), static_cast<size_t>(::sysconf(_SC_PAGESIZE)));
+    EXPECT_EQ(buffer.availableWrite(), buffer.capacity());
+    EXPECT_TRUE(buffer.isEmpty());
+}
+
+TEST(MirroredRingBufferTest, RegionsStayContiguousAcrossTheWrap)
+{
+    MirroredRingBuffer buffer(4096);
+    size_t capacity = buffer.capacity();
+
+    Write(buffer, std::string(capacity - 10, 'a'));
+    Read(buffer, capacity - 10);
+    EXPECT_EQ(buffer.readPos(), 0u);
+
+    Write(buffer, std::string(capacity - 10, 'a'));
+    Read(buffer, capacity - 20);
+    EXPECT_EQ(buffer.readPos(), capacity - 20);
+    EXPECT_EQ(buffer.availableWrite(), capacity - 10);
+
+    std::string crossing = "0123456789abcdefghijklmnopqrstuvwxyz";
+    Write(buffer, crossing);
+    EXPECT_EQ(buffer.writePos(), crossing.size() - 10);
+    EXPECT_EQ(Read(buffer, 10), std::string(10, 'a'));
+    EXPECT_EQ(Read(buffer, crossing.size()), crossing);
+    EXPECT_TRUE(buffer.isEmpty());
+}
+
+TEST(MirroredRingBufferTest, UnpacksMessageStraddlingTheWrap)
+{
+    MirroredRingBuffer buffer(4096);
+    size_t capacity = buffer.capacity();
+    Write(buffer, std::string(capacity - 5, 'a'));
+    Read(buffer, capacity - 6);
+
+    std::string text(300, 'q');
+    Packer packer(buffer.getWritePtr(), buffer.availableWrite());
+    ASSERT_TRUE(packer.pack(text));
+    buffer.commitWrite(packer.position());
+    Read(buffer, 1);
+
+    Unpacker unpacker(buffer.getReadPtr(), buffer.availableRead());
+    auto result = unpacker.unpackString();
+    ASSERT_TRUE(result);
+    EXPECT_EQ(std::string(result->data(), result->size()), text);
+}
+
+TEST(MirroredRingBufferTest, ExpandKeepsWrappedData)
+{
+    MirroredRingBuffer buffer(4096);
+    size_t capacity = buffer.capacity();
+    Write(buffer, std::string(capacity - 8, 'a'));
+    Read(buffer, capacity - 8);
+    Write(buffer, "wrapped-data");
+
+    buffer.expand(capacity * 2);
+    EXPECT_EQ(buffer.capacity(), capacity * 2);
+    EXPECT_EQ(Read(buffer, 12), "wrapped-data");
+}
+
+TEST(MirroredRingBufferTest, PoolCachesRoundedRings)
+{
+    const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    BufferPool<MirroredRingBuffer> pool(1000, 2 * pageSize);
+
+    MirroredRingBuffer first(0);
+    MirroredRingBuffer second(0);
+    pool.borrow(first);
+    ASSERT_EQ(first.capacity(), pageSize);
+    const uint8_t* memory = first.getReadPtr();
+
+    // The limit counts page sized rings, not the requested 1000 bytes.
+    EXPECT_TRUE(pool.canLend(1));
+    pool.borrow(second);
+    EXPECT_FALSE(pool.canLend(1));
+    EXPECT_EQ(pool.memoryUsage(), 2 * pageSize);
+
+    pool.giveBack(first);
+    EXPECT_EQ(pool.cachedBuffers(), 1u);
+    pool.borrow(first);
+    EXPECT_EQ(first.getReadPtr(), memory);
+
+    pool.giveBack(first);
+    pool.giveBack(second);
+    EXPECT_EQ(pool.cachedBuffers(), 2u);
+}
+
+TEST(MirroredRingBufferTest, TransportReceivesStraightIntoTheRing)
+{
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+    UnixSocket writer = UnixSocket::adopt(fds[0], true);
+    UnixSocket reader = UnixSocket::adopt(fds[1], true);
+
+    MirroredRingBuffer buffer(4096);
+    size_t capacity = buffer.capacity();
+    Write(buffer, std::string(capacity - 3, 'a'));
+    Read(buffer, capacity - 3);
+
+    std::error_code ec;
+    std::string message = "across the wrap point";
+    ASSERT_EQ(writer.send(reinterpret_cast<const uint8_t*>(message.data()), message.size(), ec),
+              static_cast<ssize_t>(message.size()));
+    ASSERT_EQ(reader.recvBuffer(buffer, ec), static_cast<ssize_t>(message.size()));
+
+    ASSERT_EQ(writer.sendBuffer(buffer, ec), static_cast<ssize_t>(message.size()));
+    uint8_t echoed[64];
+    ASSERT_EQ(reader.recv(echoed, sizeof(echoed), ec), static_cast<ssize_t>(message.size()));
+    EXPECT_EQ(std::string(reinterpret_cast<char*>(echoed), message.size()), message);
+}
+
+TEST(MirroredRingBufferBenchmark, PartialReadsAgainstByteBuffer)
+{
+    constexpr size_t kTotal = 256 << 20;
+    constexpr size_t kRead = 1460;
+    constexpr size_t kMessage = 1000;
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    ByteBuffer flat(16384);
+    size_t flatMessages = RunPartialReads(flat, kTotal, kRead, kMessage);
+    auto flatTime = Clock::now() - start;
+
+    start = Clock::now();
+    MirroredRingBuffer ring(16384);
+    size_t ringMessages = RunPartialReads(ring, kTotal, kRead, kMessage);
+    auto ringTime = Clock::now() - start;
+
+    EXPECT_EQ(flatMessages, ringMessages);
+    using Ms = std::chrono::duration<double, std::milli>;
+    std::printf("[ Ring     ] %zu MiB, %zu byte reads, %zu byte messages: ByteBuffer %.2f ms, Mirrored %.2f ms\n",
+                kTotal >> 20, kRead, kMessage, Ms(flatTime).count(), Ms(ringTime).count());
+}
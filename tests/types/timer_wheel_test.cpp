@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+#include <casket/types/timer_wheel.hpp>
+
+using namespace casket;
+using namespace std::chrono;
+
+class TimerWheelTest : public ::testing::Test
+{
+protected:
+    TimerWheel::Clock::time_point start_{TimerWheel::Clock::now()};
+    TimerWheel wheel_{milliseconds(1), start_};
+
+    TimerWheel::Clock::time_point at(int64_t ms) const
+    {
+        return start_ + milliseconds(ms);
+    }
+};
+
+TEST_F(TimerWheelTest, FiresAtExpiry)
+{
+    int fired = 0;
+    wheel_.scheduleAfter(milliseconds(250), [&fired] { ++fired; }, start_);
+
+    EXPECT_EQ(wheel_.advance(at(249)), 0U);
+    EXPECT_EQ(fired, 0);
+    EXPECT_EQ(wheel_.advance(at(250)), 1U);
+    EXPECT_EQ(fired, 1);
+    EXPECT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimerWheelTest, FiresInExpiryOrderAcrossLevels)
+{
+    std::vector<int> order;
+    const std::vector<int> delays{70000, 5, 4100, 300, 64, 1};
+
+    for (int delay : delays)
+    {
+        wheel_.scheduleAfter(milliseconds(delay), [&order, delay] { order.push_back(delay); }, start_);
+    }
+
+    for (int ms = 1; ms <= 70000; ++ms)
+    {
+        wheel_.advance(at(ms));
+    }
+
+    EXPECT_EQ(order, (std::vector<int>{1, 5, 64, 300, 4100, 70000}));
+}
+
+TEST_F(TimerWheelTest, LargeJumpFiresEverything)
+{
+    int fired = 0;
+    for (int i = 1; i <= 100; ++i)
+    {
+        wheel_.scheduleAfter(milliseconds(i * 997), [&fired] { ++fired; }, start_);
+    }
+
+    EXPECT_EQ(wheel_.advance(at(100 * 997)), 100U);
+    EXPECT_EQ(fired, 100);
+}
+
+TEST_F(TimerWheelTest, BeyondRangeIsParked)
+{
+    int fired = 0;
+    const int64_t delay = int64_t(1) << 25;
+    wheel_.scheduleAfter(milliseconds(delay), [&fired] { ++fired; }, start_);
+
+    wheel_.advance(at(delay - 1));
+    EXPECT_EQ(fired, 0);
+    wheel_.advance(at(delay));
+    EXPECT_EQ(fired, 1);
+}
+
+TEST_F(TimerWheelTest, CancelHandle)
+{
+    int fired = 0;
+    auto handle = wheel_.scheduleAfter(milliseconds(10), [&fired] { ++fired; }, start_);
+
+    EXPECT_TRUE(wheel_.cancel(handle));
+    EXPECT_FALSE(wheel_.cancel(handle));
+    EXPECT_TRUE(wheel_.empty());
+
+    wheel_.advance(at(20));
+    EXPECT_EQ(fired, 0);
+}
+
+TEST_F(TimerWheelTest, StaleHandleDoesNotCancelReusedSlot)
+{
+    int fired = 0;
+    auto first = wheel_.scheduleAfter(milliseconds(1), [] {}, start_);
+    wheel_.advance(at(1));
+
+    wheel_.scheduleAfter(milliseconds(5), [&fired] { ++fired; }, at(1));
+    EXPECT_FALSE(wheel_.cancel(first));
+
+    wheel_.advance(at(6));
+    EXPECT_EQ(fired, 1);
+}
+
+TEST_F(TimerWheelTest, IntrusiveTimerReschedulesItself)
+{
+    int fired = 0;
+    TimerWheel::Timer timer;
+    timer.setCallback(
+        [&]()
+        {
+            if (++fired < 3)
+            {
+                wheel_.schedule(timer, milliseconds(10), at(fired * 10));
+            }
+        });
+
+    wheel_.schedule(timer, milliseconds(10), start_);
+    for (int ms = 1; ms <= 100; ++ms)
+    {
+        wheel_.advance(at(ms));
+    }
+
+    EXPECT_EQ(fired, 3);
+    EXPECT_FALSE(timer.isScheduled());
+}
+
+TEST_F(TimerWheelTest, DestroyedTimerIsUnlinked)
+{
+    {
+        TimerWheel::Timer timer([] { FAIL(); });
+        wheel_.schedule(timer, milliseconds(10), start_);
+        EXPECT_EQ(wheel_.size(), 1U);
+    }
+
+    EXPECT_TRUE(wheel_.empty());
+    wheel_.advance(at(20));
+}
+
+TEST_F(TimerWheelTest, NextTimeout)
+{
+    EXPECT_EQ(wheel_.nextTimeout(start_), TimerWheel::Clock::duration::max());
+    EXPECT_EQ(wheel_.nextTimeoutMs(100, start_), 100);
+
+    wheel_.scheduleAfter(milliseconds(30), [] {}, start_);
+    EXPECT_EQ(wheel_.nextTimeout(start_), milliseconds(30));
+    EXPECT_EQ(wheel_.nextTimeoutMs(10, start_), 10);
+    EXPECT_EQ(wheel_.nextTimeoutMs(-1, at(25)), 5);
+
+    // A timer on an upper level reports the cascade tick, never a time past its expiry.
+    wheel_.scheduleAfter(milliseconds(1000), [] {}, start_);
+    wheel_.advance(at(30));
+    EXPECT_LE(wheel_.nextTimeout(at(30)), milliseconds(970));
+}
+
+TEST_F(TimerWheelTest, NextTimeoutMsClampsDistantTimers)
+{
+    TimerWheel wheel(std::chrono::seconds(1), start_);
+    wheel.scheduleAfter(std::chrono::hours(24 * 30), [] {}, start_);
+
+    EXPECT_GT(wheel.nextTimeout(start_), milliseconds(std::numeric_limits<int>::max()));
+    EXPECT_EQ(wheel.nextTimeoutMs(-1, start_), std::numeric_limits<int>::max());
+    EXPECT_EQ(wheel.nextTimeoutMs(100, start_), 100);
+}
@@ -409,3 +409,34 @@ TEST(TtlCacheTest, MixedOperations)
     EXPECT_GT(found, 0);
     EXPECT_LT(found, 100);
 }
+
+TEST(TtlCacheTest, PurgeExpiredRemovesOnlyExpiredEntries)
+{
+    TtlCache<int, int> cache(10);
+    auto now = std::chrono::steady_clock::now();
+
+    cache.put(1, 1, now + std::chrono::seconds(1));
+    cache.put(2, 2, now + std::chrono::seconds(60));
+    cache.put(3, 3, now + std::chrono::seconds(1));
+
+    EXPECT_EQ(cache.purgeExpired(now), 0U);
+    EXPECT_EQ(cache.purgeExpired(now + std::chrono::seconds(2)), 2U);
+    EXPECT_EQ(cache.size(), 1U);
+    EXPECT_NE(cache.get(2, now), nullptr);
+}
+
+TEST(TtlCacheTest, PurgeExpiredIsBounded)
+{
+    TtlCache<int, int> cache(10);
+    auto now = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < 6; ++i)
+    {
+        cache.put(i, i, now);
+    }
+
+    EXPECT_EQ(cache.purgeExpired(now, 4), 4U);
+    EXPECT_EQ(cache.size(), 2U);
+    EXPECT_EQ(cache.purgeExpired(now, 4), 2U);
+    EXPECT_TRUE(cache.empty());
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <casket/utils/histogram.hpp>
+
+using namespace casket;
+
+TEST(HistogramTest, Empty)
+{
+    Log2Histogram histogram;
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 0.0);
+}
+
+TEST(HistogramTest, BucketIndex)
+{
+    EXPECT_EQ(Log2Histogram::bucketIndex(0), 0u);
+    EXPECT_EQ(Log2Histogram::bucketIndex(1), 1u);
+    EXPECT_EQ(Log2Histogram::bucketIndex(2), 2u);
+    EXPECT_EQ(Log2Histogram::bucketIndex(3), 2u);
+    EXPECT_EQ(Log2Histogram::bucketIndex(1024), 11u);
+    EXPECT_EQ(Log2Histogram::bucketIndex(UINT64_MAX), 64u);
+}
+
+TEST(HistogramTest, RecordAndPercentile)
+{
+    Log2Histogram histogram;
+    for (uint64_t i = 1; i <= 100; ++i)
+    {
+        histogram.record(i);
+    }
+
+    EXPECT_EQ(histogram.count(), 100u);
+    EXPECT_EQ(histogram.sum(), 5050u);
+    EXPECT_EQ(histogram.max(), 100u);
+    EXPECT_EQ(histogram.percentile(0.5), 64u);
+    EXPECT_EQ(histogram.percentile(1.0), 100u);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+}